@@ -0,0 +1,528 @@
+#include "basic_big_integer.h"
+#include <string>
+#include <algorithm>
+#include <utility>
+
+const char MINUS_SIGN = '-';
+const string MINUS_STR = "-";
+
+/* a limb wide enough to hold the sum of DECIMAL_SCHOOLBOOK_LIMIT limb products */
+typedef unsigned __int128 dlimb_t;
+
+/* products whose shorter operand has fewer limbs are computed in base 10^18, longer ones in
+ * binary. 64 products below 10^36 each still fit a 128 bit column sum */
+const size_t DECIMAL_SCHOOLBOOK_LIMIT = 64;
+
+const decimal_big_integer::limb_t decimal_big_integer::BASE;
+const size_t decimal_big_integer::BASE_DIGITS;
+
+/**
+ * get an integer and construct a big number
+ * @param number a number
+ */
+decimal_big_integer::decimal_big_integer(int number) : _limbs(), _isPositive(number >= 0)
+{
+    // the magnitude of any int is below BASE, the unsigned negation also covers INT_MIN
+    limb_t magnitude = number >= 0 ? limb_t(number) : limb_t(0) - limb_t(number);
+    if (magnitude != 0)
+    {
+        _limbs.push_back(magnitude);
+    }
+}
+
+/**
+ * get a string and construct a big number, a string that is not a number gives 0
+ * @param number a string
+ */
+decimal_big_integer::decimal_big_integer(const string &number) : _limbs(), _isPositive(true)
+{
+    if (number.length() == 0 || number == MINUS_STR)
+    {
+        return;
+    }
+    size_t start = number[0] == MINUS_SIGN ? 1 : 0;
+    for (size_t i = start; i < number.length(); i++)
+    {
+        if (number[i] < '0' || number[i] > '9')
+        {
+            return;
+        }
+    }
+    _parseDigits(number.data() + start, number.length() - start);
+    _isPositive = start == 0 || _limbs.empty();
+}
+
+/**
+ * convert from binary limbs
+ * @param num a big_integer
+ */
+decimal_big_integer::decimal_big_integer(const big_integer &num) : _limbs(),
+                                                                  _isPositive(num._isPositive)
+{
+    string digits = num._toDecimalString();
+    _parseDigits(digits.data(), digits.length());
+}
+
+/**
+ * move constructor, takes the limbs of other and leaves it 0
+ * @param other the number to move
+ */
+decimal_big_integer::decimal_big_integer(decimal_big_integer &&other) noexcept
+        : _limbs(std::move(other._limbs)), _isPositive(other._isPositive)
+{
+    other._limbs.clear();
+    other._isPositive = true;
+}
+
+/**
+ * move = operator, takes the limbs of other and leaves it 0
+ * @param other the other decimal_big_integer
+ * @return this integer
+ */
+decimal_big_integer &decimal_big_integer::operator=(decimal_big_integer &&other) noexcept
+{
+    if (this != &other)
+    {
+        _limbs = std::move(other._limbs);
+        _isPositive = other._isPositive;
+        other._limbs.clear();
+        other._isPositive = true;
+    }
+    return *this;
+}
+
+/**
+ * convert to binary limbs
+ * @return the value as a big_integer
+ */
+decimal_big_integer::operator big_integer() const
+{
+    if (_limbs.empty())
+    {
+        return big_integer();
+    }
+    string digits = _digits();
+    big_integer res = big_integer::_parseDecimal(digits.data(), digits.length());
+    res._isPositive = _isPositive;
+    return res;
+}
+
+/**
+ * put the number in a stream
+ * @param output the stream
+ * @param num the number to put in the stream
+ * @return an updated stream
+ */
+ostream &operator<<(ostream &output, const decimal_big_integer &num)
+{
+    output << num.to_string();
+    return output;
+}
+
+/**
+ * @return the decimal digits of the number, with a leading '-' if it is negative
+ */
+string decimal_big_integer::to_string() const
+{
+    if (_isPositive)
+    {
+        return _digits();
+    }
+    return MINUS_STR + _digits();
+}
+
+/**
+ * adds this to other and return the result
+ * @param other decimal_big_integer
+ * @return this + other
+ */
+decimal_big_integer decimal_big_integer::operator+(const decimal_big_integer &other) const
+{
+    decimal_big_integer res;
+    _addSigned(res, *this, other, false);
+    return res;
+}
+
+/**
+ * substract other from this and return the result
+ * @param other decimal_big_integer
+ * @return this - other
+ */
+decimal_big_integer decimal_big_integer::operator-(const decimal_big_integer &other) const
+{
+    decimal_big_integer res;
+    _addSigned(res, *this, other, true);
+    return res;
+}
+
+/**
+ * this function calculate this += other
+ * @param other decimal_big_integer
+ * @return this after doing this += other
+ */
+decimal_big_integer &decimal_big_integer::operator+=(const decimal_big_integer &other)
+{
+    _addSigned(*this, *this, other, false);
+    return *this;
+}
+
+/**
+ * this function calculate this -= other
+ * @param other decimal_big_integer
+ * @return this after doing this -= other
+ */
+decimal_big_integer &decimal_big_integer::operator-=(const decimal_big_integer &other)
+{
+    _addSigned(*this, *this, other, true);
+    return *this;
+}
+
+/**
+ * multiply this to other and return the result
+ * @param other decimal_big_integer
+ * @return this * other
+ */
+decimal_big_integer decimal_big_integer::operator*(const decimal_big_integer &other) const
+{
+    decimal_big_integer res(*this);
+    res *= other;
+    return res;
+}
+
+/**
+ * assigns other * this to this
+ * @param other decimal_big_integer
+ * @return this after doing this * other
+ */
+decimal_big_integer &decimal_big_integer::operator*=(const decimal_big_integer &other)
+{
+    if (_limbs.empty() || other._limbs.empty())
+    {
+        _limbs.clear();
+        _isPositive = true;
+        return *this;
+    }
+    bool positive = _isPositive == other._isPositive;
+    const limb_vector &longer = _limbs.size() >= other._limbs.size() ? _limbs : other._limbs;
+    const limb_vector &shorter = _limbs.size() >= other._limbs.size() ? other._limbs : _limbs;
+    if (shorter.size() < DECIMAL_SCHOOLBOOK_LIMIT)
+    {
+        limb_vector product;
+        _multiplyColumns(product, longer, shorter);
+        _limbs = std::move(product);
+    }
+    else
+    {
+        // the binary product is subquadratic, the two conversions cost about as much as it
+        *this = decimal_big_integer(static_cast<big_integer>(*this) *
+                                    static_cast<big_integer>(other));
+    }
+    _isPositive = positive;
+    return *this;
+}
+
+/**
+ * divide: this / other
+ * @param other divisor
+ * @return this / other
+ */
+decimal_big_integer decimal_big_integer::operator/(const decimal_big_integer &other) const
+{
+    decimal_big_integer quotient, remainder;
+    divmod(*this, other, quotient, remainder);
+    return quotient;
+}
+
+/**
+ * this function calculate (this /= other)
+ * @param other decimal_big_integer
+ * @return this after doing (this /= other)
+ */
+decimal_big_integer &decimal_big_integer::operator/=(const decimal_big_integer &other)
+{
+    decimal_big_integer remainder;
+    divmod(*this, other, *this, remainder);
+    return *this;
+}
+
+/**
+ * divide: this % other
+ * @param other divisor
+ * @return this % other
+ */
+decimal_big_integer decimal_big_integer::operator%(const decimal_big_integer &other) const
+{
+    decimal_big_integer quotient, remainder;
+    divmod(*this, other, quotient, remainder);
+    return remainder;
+}
+
+/**
+ * divide num1 by num2 once into caller provided outputs.
+ * the outputs may be the inputs themselves but must be two different objects.
+ * @param num1 the dividend
+ * @param num2 the divisor
+ * @param quotient output, num1 / num2
+ * @param remainder output, num1 % num2
+ */
+void decimal_big_integer::divmod(const decimal_big_integer &num1, const decimal_big_integer &num2,
+                                 decimal_big_integer &quotient, decimal_big_integer &remainder)
+{
+    if (num2._limbs.empty())
+    {
+        quotient._limbs.clear();
+        quotient._isPositive = true;
+        remainder._limbs.clear();
+        remainder._isPositive = true;
+        return;
+    }
+    if (num2._limbs.size() > 1)
+    {
+        big_integer binaryQuotient, binaryRemainder;
+        big_integer::divmod(static_cast<big_integer>(num1), static_cast<big_integer>(num2),
+                            binaryQuotient, binaryRemainder);
+        quotient = decimal_big_integer(binaryQuotient);
+        remainder = decimal_big_integer(binaryRemainder);
+        return;
+    }
+    // a single limb divisor is a linear short division, the signs follow big_integer:
+    // the quotient truncates and the remainder takes its sign
+    bool positive = num1._isPositive == num2._isPositive;
+    limb_t divisor = num2._limbs[0];
+    limb_vector quotientLimbs;
+    limb_t rest = _divideBySmall(quotientLimbs, num1._limbs, divisor);
+    quotient._limbs = std::move(quotientLimbs);
+    quotient._isPositive = positive || quotient._limbs.empty();
+    remainder._limbs.assign(rest != 0 ? 1 : 0, rest);
+    remainder._isPositive = positive || rest == 0;
+}
+
+/**
+ * three way comparison
+ * @param other the number to compare to
+ * @return -1 if this < other, 0 if they are equal, 1 if this > other
+ */
+int decimal_big_integer::compare(const decimal_big_integer &other) const
+{
+    if (_isPositive != other._isPositive)
+    {
+        return _isPositive ? 1 : -1;
+    }
+    int res = big_integer::_compareMagnitude(_limbs.data(), _limbs.size(), other._limbs.data(),
+                                             other._limbs.size());
+    res = (res > 0) - (res < 0);
+    return _isPositive ? res : -res;
+}
+
+/**
+ * @param other the number to compare to
+ * @return true if this == other
+ */
+bool decimal_big_integer::operator==(const decimal_big_integer &other) const
+{
+    return _isPositive == other._isPositive && _limbs == other._limbs;
+}
+
+/**
+ * @param other the number to compare to
+ * @return true if this != other
+ */
+bool decimal_big_integer::operator!=(const decimal_big_integer &other) const
+{
+    return !(*this == other);
+}
+
+/**
+ * @param other the number to compare to
+ * @return true if this > other
+ */
+bool decimal_big_integer::operator>(const decimal_big_integer &other) const
+{
+    return compare(other) > 0;
+}
+
+/**
+ * @param other the number to compare to
+ * @return true if this < other
+ */
+bool decimal_big_integer::operator<(const decimal_big_integer &other) const
+{
+    return compare(other) < 0;
+}
+
+/**
+ * @param other the number to compare to
+ * @return true if this >= other
+ */
+bool decimal_big_integer::operator>=(const decimal_big_integer &other) const
+{
+    return compare(other) >= 0;
+}
+
+/**
+ * @param other the number to compare to
+ * @return true if this <= other
+ */
+bool decimal_big_integer::operator<=(const decimal_big_integer &other) const
+{
+    return compare(other) <= 0;
+}
+
+/**
+ * result = num1 + num2 (or num1 - num2), result may be one of the operands
+ * @param result output
+ * @param num1 a number
+ * @param num2 a number
+ * @param negate true to substract num2
+ */
+void decimal_big_integer::_addSigned(decimal_big_integer &result, const decimal_big_integer &num1,
+                                     const decimal_big_integer &num2, bool negate)
+{
+    size_t len1 = num1._limbs.size(), len2 = num2._limbs.size();
+    bool positive2 = num2._isPositive != negate || len2 == 0;
+    if (num1._isPositive == positive2)
+    {
+        // same signs, the magnitudes add up. the pointers are taken after the resize since
+        // result may be an operand
+        size_t len = std::max(len1, len2);
+        bool positive = num1._isPositive;
+        result._limbs.resize(len + 1);
+        const limb_t *limbs1 = num1._limbs.data(), *limbs2 = num2._limbs.data();
+        limb_t *out = result._limbs.data(), carry = 0;
+        for (size_t i = 0; i < len; i++)
+        {
+            limb_t sum = (i < len1 ? limbs1[i] : 0) + (i < len2 ? limbs2[i] : 0) + carry;
+            carry = sum >= BASE;
+            out[i] = carry ? sum - BASE : sum;
+        }
+        out[len] = carry;
+        result._isPositive = positive;
+    }
+    else
+    {
+        // different signs, the smaller magnitude is taken from the larger one
+        int order = big_integer::_compareMagnitude(num1._limbs.data(), len1, num2._limbs.data(),
+                                                   len2);
+        const decimal_big_integer &larger = order >= 0 ? num1 : num2;
+        const decimal_big_integer &smaller = order >= 0 ? num2 : num1;
+        size_t len = std::max(len1, len2), smallLen = std::min(len1, len2);
+        bool positive = order >= 0 ? num1._isPositive : positive2;
+        result._limbs.resize(len);
+        const limb_t *big = larger._limbs.data(), *small = smaller._limbs.data();
+        limb_t *out = result._limbs.data(), borrow = 0;
+        for (size_t i = 0; i < len; i++)
+        {
+            limb_t subtrahend = (i < smallLen ? small[i] : 0) + borrow;
+            borrow = big[i] < subtrahend;
+            out[i] = borrow ? big[i] + BASE - subtrahend : big[i] - subtrahend;
+        }
+        result._isPositive = positive;
+    }
+    big_integer::_normalize(result._limbs);
+    result._isPositive = result._isPositive || result._limbs.empty();
+}
+
+/**
+ * product of two magnitudes column by column, every column sum is kept in 128 bits and
+ * split into a limb and a carry once
+ * @param result output, normalized
+ * @param num1 a magnitude
+ * @param num2 a magnitude, shorter than DECIMAL_SCHOOLBOOK_LIMIT limbs
+ */
+void decimal_big_integer::_multiplyColumns(limb_vector &result, const limb_vector &num1,
+                                           const limb_vector &num2)
+{
+    size_t len1 = num1.size(), len2 = num2.size();
+    result.resize(len1 + len2);
+    dlimb_t carry = 0;
+    for (size_t column = 0; column + 1 < len1 + len2; column++)
+    {
+        // the pairs (i, column - i) with i in num1 and column - i in num2
+        size_t first = column >= len2 ? column - len2 + 1 : 0;
+        size_t last = std::min(column, len1 - 1);
+        dlimb_t sum = carry;
+        for (size_t i = first; i <= last; i++)
+        {
+            sum += dlimb_t(num1[i]) * num2[column - i];
+        }
+        carry = sum / BASE;
+        result[column] = limb_t(sum - carry * BASE);
+    }
+    // the product is below BASE^(len1 + len2), so the last carry is a single limb
+    result[len1 + len2 - 1] = limb_t(carry);
+    big_integer::_normalize(result);
+}
+
+/**
+ * divide a magnitude by a single limb
+ * @param quotient output, normalized
+ * @param num a magnitude
+ * @param divisor a non zero limb
+ * @return the remainder
+ */
+decimal_big_integer::limb_t decimal_big_integer::_divideBySmall(limb_vector &quotient,
+                                                                const limb_vector &num,
+                                                                limb_t divisor)
+{
+    size_t len = num.size();
+    quotient.resize(len);
+    dlimb_t rest = 0;
+    for (size_t i = len; i > 0; i--)
+    {
+        dlimb_t current = rest * BASE + num[i - 1];
+        quotient[i - 1] = limb_t(current / divisor);
+        rest = current - dlimb_t(quotient[i - 1]) * divisor;
+    }
+    big_integer::_normalize(quotient);
+    return limb_t(rest);
+}
+
+/**
+ * read the magnitude out of decimal digits, 18 digits per limb from the end
+ * @param digits the digits
+ * @param len number of digits
+ */
+void decimal_big_integer::_parseDigits(const char *digits, size_t len)
+{
+    _limbs.resize((len + BASE_DIGITS - 1) / BASE_DIGITS);
+    size_t end = len;
+    for (size_t i = 0; i < _limbs.size(); i++)
+    {
+        size_t begin = end >= BASE_DIGITS ? end - BASE_DIGITS : 0;
+        limb_t limb = 0;
+        for (size_t j = begin; j < end; j++)
+        {
+            limb = limb * 10 + limb_t(digits[j] - '0');
+        }
+        _limbs[i] = limb;
+        end = begin;
+    }
+    big_integer::_normalize(_limbs);
+}
+
+/**
+ * @return the decimal digits of the magnitude, "0" for 0
+ */
+string decimal_big_integer::_digits() const
+{
+    if (_limbs.empty())
+    {
+        return "0";
+    }
+    // the top limb is printed as is, every lower limb as exactly BASE_DIGITS digits
+    string top = std::to_string(_limbs.back());
+    size_t lower = _limbs.size() - 1;
+    string numStr = top;
+    numStr.resize(top.length() + lower * BASE_DIGITS);
+    char *position = &numStr[0] + numStr.length();
+    for (size_t i = 0; i < lower; i++)
+    {
+        limb_t limb = _limbs[i];
+        for (size_t j = 0; j < BASE_DIGITS; j++)
+        {
+            *--position = char('0' + limb % 10);
+            limb /= 10;
+        }
+    }
+    return numStr;
+}
@@ -0,0 +1,297 @@
+#ifndef EX1_BASIC_BIG_INTEGER_H
+#define EX1_BASIC_BIG_INTEGER_H
+
+#include <iostream>
+#include <cstdint>
+#include <cstddef>
+#include "big_integer.h"
+
+/**
+ * a big integer kept in decimal limbs (base 10^18, least significant limb first).
+ * parsing and printing only regroup digits, so they take linear time, while big_integer
+ * needs a divide and conquer base conversion for both. additions and short products and
+ * divisions are computed in base 10^18 directly, long products and divisions convert the
+ * operands to big_integer and the result back.
+ * the operators and their semantics are those of big_integer: invalid text is 0, division
+ * truncates, x / 0 and x % 0 are 0, and the remainder takes the sign of the quotient.
+ * @author Idan Yamin
+ * @class decimal_big_integer
+ */
+class decimal_big_integer
+{
+public:
+    /* a single digit of the magnitude in base 10^18 */
+    typedef big_integer::limb_t limb_t;
+
+    /* the base of the limbs, the sum of two limbs still fits a limb */
+    static const limb_t BASE = 1000000000000000000ULL;
+
+    /* number of decimal digits in a limb */
+    static const size_t BASE_DIGITS = 18;
+
+    /**
+     * default constructor, create a 0 decimal_big_integer
+     */
+    decimal_big_integer() : _limbs(), _isPositive(true)
+    {};
+
+    /**
+     * get an integer and construct a big number
+     * @param number a number
+     */
+    decimal_big_integer(int number);
+
+    /**
+     * get a string and construct a big number, a string that is not a number gives 0
+     * @param number a string
+     */
+    decimal_big_integer(const string &number);
+
+    /**
+     * convert from binary limbs
+     * @param num a big_integer
+     */
+    explicit decimal_big_integer(const big_integer &num);
+
+    /**
+     * copy constructor
+     * @param other the number to copy
+     */
+    decimal_big_integer(const decimal_big_integer &other) = default;
+
+    /**
+     * move constructor, takes the limbs of other and leaves it 0
+     * @param other the number to move
+     */
+    decimal_big_integer(decimal_big_integer &&other) noexcept;
+
+    /**
+     * convert to binary limbs
+     * @return the value as a big_integer
+     */
+    explicit operator big_integer() const;
+
+    /**
+     * put the number in a stream
+     * @param output the stream
+     * @param num the number to put in the stream
+     * @return an updated stream
+     */
+    friend ostream &operator<<(ostream &output, const decimal_big_integer &num);
+
+    /**
+     * @return the decimal digits of the number, with a leading '-' if it is negative
+     */
+    string to_string() const;
+
+    /**
+     * adds this to other and return the result
+     * @param other decimal_big_integer
+     * @return this + other
+     */
+    decimal_big_integer operator+(const decimal_big_integer &other) const;
+
+    /**
+     * substract other from this and return the result
+     * @param other decimal_big_integer
+     * @return this - other
+     */
+    decimal_big_integer operator-(const decimal_big_integer &other) const;
+
+    /**
+     * this function calculate this += other
+     * @param other decimal_big_integer
+     * @return this after doing this += other
+     */
+    decimal_big_integer &operator+=(const decimal_big_integer &other);
+
+    /**
+     * this function calculate this -= other
+     * @param other decimal_big_integer
+     * @return this after doing this -= other
+     */
+    decimal_big_integer &operator-=(const decimal_big_integer &other);
+
+    /**
+     * multiply this to other and return the result
+     * @param other decimal_big_integer
+     * @return this * other
+     */
+    decimal_big_integer operator*(const decimal_big_integer &other) const;
+
+    /**
+     * assigns other * this to this
+     * @param other decimal_big_integer
+     * @return this after doing this * other
+     */
+    decimal_big_integer &operator*=(const decimal_big_integer &other);
+
+    /**
+     * divide: this / other
+     * @param other divisor
+     * @return this / other
+     */
+    decimal_big_integer operator/(const decimal_big_integer &other) const;
+
+    /**
+     * this function calculate (this /= other)
+     * @param other decimal_big_integer
+     * @return this after doing (this /= other)
+     */
+    decimal_big_integer &operator/=(const decimal_big_integer &other);
+
+    /**
+     * divide: this % other
+     * @param other divisor
+     * @return this % other
+     */
+    decimal_big_integer operator%(const decimal_big_integer &other) const;
+
+    /**
+     * = operator
+     * @param other the other decimal_big_integer
+     * @return this integer after copying other
+     */
+    decimal_big_integer &operator=(const decimal_big_integer &other) = default;
+
+    /**
+     * move = operator, takes the limbs of other and leaves it 0
+     * @param other the other decimal_big_integer
+     * @return this integer
+     */
+    decimal_big_integer &operator=(decimal_big_integer &&other) noexcept;
+
+    /**
+     * three way comparison
+     * @param other the number to compare to
+     * @return -1 if this < other, 0 if they are equal, 1 if this > other
+     */
+    int compare(const decimal_big_integer &other) const;
+
+    /**
+     * @param other the number to compare to
+     * @return true if this == other
+     */
+    bool operator==(const decimal_big_integer &other) const;
+
+    /**
+     * @param other the number to compare to
+     * @return true if this != other
+     */
+    bool operator!=(const decimal_big_integer &other) const;
+
+    /**
+     * @param other the number to compare to
+     * @return true if this > other
+     */
+    bool operator>(const decimal_big_integer &other) const;
+
+    /**
+     * @param other the number to compare to
+     * @return true if this < other
+     */
+    bool operator<(const decimal_big_integer &other) const;
+
+    /**
+     * @param other the number to compare to
+     * @return true if this >= other
+     */
+    bool operator>=(const decimal_big_integer &other) const;
+
+    /**
+     * @param other the number to compare to
+     * @return true if this <= other
+     */
+    bool operator<=(const decimal_big_integer &other) const;
+
+    /**
+     * divide num1 by num2 once into caller provided outputs.
+     * the outputs may be the inputs themselves but must be two different objects.
+     * @param num1 the dividend
+     * @param num2 the divisor
+     * @param quotient output, num1 / num2
+     * @param remainder output, num1 % num2
+     */
+    static void divmod(const decimal_big_integer &num1, const decimal_big_integer &num2,
+                       decimal_big_integer &quotient, decimal_big_integer &remainder);
+
+private:
+    /* the magnitude, normalized: no leading zero limbs, empty for 0 */
+    limb_vector _limbs;
+
+    /* the sign, true for 0 */
+    bool _isPositive;
+
+    /**
+    * result = num1 + num2 (or num1 - num2), result may be one of the operands
+    * @param result output
+    * @param num1 a number
+    * @param num2 a number
+    * @param negate true to substract num2
+    */
+    static void _addSigned(decimal_big_integer &result, const decimal_big_integer &num1,
+                           const decimal_big_integer &num2, bool negate);
+
+    /**
+    * product of two magnitudes column by column, every column sum is kept in 128 bits and
+    * split into a limb and a carry once
+    * @param result output, normalized
+    * @param num1 a magnitude
+    * @param num2 a magnitude, shorter than DECIMAL_SCHOOLBOOK_LIMIT limbs
+    */
+    static void _multiplyColumns(limb_vector &result, const limb_vector &num1,
+                                 const limb_vector &num2);
+
+    /**
+    * divide a magnitude by a single limb
+    * @param quotient output, normalized
+    * @param num a magnitude
+    * @param divisor a non zero limb
+    * @return the remainder
+    */
+    static limb_t _divideBySmall(limb_vector &quotient, const limb_vector &num, limb_t divisor);
+
+    /**
+    * read the magnitude out of decimal digits, 18 digits per limb from the end
+    * @param digits the digits
+    * @param len number of digits
+    */
+    void _parseDigits(const char *digits, size_t len);
+
+    /**
+    * @return the decimal digits of the magnitude, "0" for 0
+    */
+    string _digits() const;
+};
+
+/**
+ * the binary radix of basic_big_integer, limbs in base 2^64 for fast arithmetic
+ * @struct binary_radix
+ */
+struct binary_radix
+{
+    /* the number type of this radix */
+    typedef big_integer type;
+};
+
+/**
+ * the decimal radix of basic_big_integer, limbs in base 10^18 for fast parsing and printing
+ * @struct decimal_radix
+ */
+struct decimal_radix
+{
+    /* the number type of this radix */
+    typedef decimal_big_integer type;
+};
+
+/**
+ * a big integer whose limb radix is chosen at compile time. both radixes have the same
+ * operators, and each converts to the other with an explicit conversion:
+ * big_integer(decimal) and decimal_big_integer(binary).
+ * @tparam Radix binary_radix or decimal_radix
+ */
+template<class Radix>
+using basic_big_integer = typename Radix::type;
+
+
+#endif //EX1_BASIC_BIG_INTEGER_H
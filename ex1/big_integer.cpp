@@ -1,611 +1,4796 @@
 #include "big_integer.h"
 #include <iostream>
 #include <string>
+#include <algorithm>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <memory>
+#include <iterator>
+#include <cstring>
+#include <cmath>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 const char MINUS_SIGN = '-';
 const string MINUS_STR = "-";
 
+/* a limb wide enough to hold the product of two limbs */
+typedef unsigned __int128 dlimb_t;
+
+/* number of bits in a limb */
+const int LIMB_BITS = 64;
+
+/* multipliers of the limb hash, odd constants with well mixed bits */
+const std::uint64_t HASH_MULTIPLIER1 = 0xa0761d6478bd642fULL;
+const std::uint64_t HASH_MULTIPLIER2 = 0xe7037ed1a0b428dbULL;
+
+/* exponent lengths (in bits) above which the powmod window grows, the first entry
+ * selects a window of WINDOW_LIMITS_FIRST_WIDTH bits and each later one a bit less */
+const size_t WINDOW_LIMITS[] = {671, 239, 79, 23};
+const size_t WINDOW_LIMITS_FIRST_WIDTH = 6;
+
+/* gcd operands from this length on (in limbs) are reduced by the half gcd, shorter ones
+ * only by lehmer steps */
+const size_t HALF_GCD_THRESHOLD = 600;
+
+/* number of leading bits a lehmer step works on, the cofactors then fit a signed word */
+const size_t LEHMER_BITS = 62;
+
+/* bit i is set if i is a square modulo 64 */
+const std::uint64_t SQUARES_MOD_64 = 0x0202021202030213ULL;
+
+/* 63 * 65 * 11, a non square modulo any of its factors cannot be a square */
+const big_integer::limb_t SQUARE_FILTER_MODULUS = 45045;
+
+/* p-th powers are filtered by their residues modulo up to this many primes q = 1 mod p */
+const unsigned int POWER_FILTER_MODULI = 4;
+
+/* the filter primes q stay below this bound, so trial division and q^2 fit native words */
+const std::uint64_t POWER_FILTER_LIMIT = 1ULL << 31;
+
+/* roots of at most this many bits are seeded from a floating point estimate */
+const size_t ROOT_SEED_BITS = 64;
+
+/* 2^64 as a double, the first value a floating point seed cannot be converted from */
+const double WORD_RANGE = 18446744073709551616.0;
+
+/* the floating point estimate of a word sized root is within a relative 2^-45 of the root,
+ * raising it by this relative margin puts it above the root */
+const double ROOT_SEED_MARGIN = 1.0 / 4294967296.0;
+
+/* relative tolerance of log2(root^p) = log2(num) for a word sized candidate root, far above
+ * the floating point error and far below the gap to any wrong candidate */
+const double ROOT_LOG_TOLERANCE = 1e-9;
+
+/* additions and substractions of at least this many limbs go through the vector kernel */
+const size_t VECTOR_CARRY_THRESHOLD = 16;
+
+/* the first byte of the sort key of negative and non negative numbers */
+const unsigned char SORT_KEY_NEGATIVE = 0x00;
+const unsigned char SORT_KEY_NON_NEGATIVE = 0x01;
+
+/* the sign byte and the 8 byte limb count that start every sort key */
+const size_t SORT_KEY_HEADER_SIZE = 9;
+
+/* the version byte that starts the binary encoding of serialize */
+const unsigned char SERIAL_VERSION = 1;
+
+/* the sign byte of the binary encoding */
+const unsigned char SERIAL_NON_NEGATIVE = 0x00;
+const unsigned char SERIAL_NEGATIVE = 0x01;
+
+/* a varint byte carries 7 bits of the value, the high bit marks that more bytes follow */
+const int SERIAL_VARINT_BITS = 7;
+const unsigned char SERIAL_VARINT_MORE = 0x80;
+
+/* a 64 bit varint takes at most 10 bytes */
+const size_t SERIAL_VARINT_MAX_BYTES = 10;
+
+/* bytes in a serialized limb */
+const size_t SERIAL_LIMB_BYTES = 8;
+
+/* the largest power of 10 that fits in a limb */
+const big_integer::limb_t DECIMAL_CHUNK = 10000000000000000000ULL;
+
+/* number of decimal digits in DECIMAL_CHUNK */
+const unsigned long DECIMAL_CHUNK_DIGITS = 19;
+
+/* binomial(n, k) divides the product of the top k factors by k! instead of sieving up to n
+ * when n is more than this many times k */
+const std::uint64_t BINOMIAL_DIVISION_RATIO = 64;
+
+/* numbers from this length (in limbs) are converted to decimal recursively */
+const size_t DECIMAL_CONVERSION_THRESHOLD = 40;
+
+/* numbers from this length (in limbs) are parsed from decimal recursively, the chunked
+ * parsing loop is cheaper than the printing one so it pays off for longer */
+const size_t DECIMAL_PARSE_THRESHOLD = 400;
+
+/* the cached powers 10^(19 * 2^i), a deque keeps references valid while it grows */
+static std::deque<big_integer> decimalPowers;
+
+/* guards decimalPowers */
+static std::mutex decimalPowersMutex;
+
+/* the smallest threshold that still splits operands into strictly smaller ones */
+const size_t MIN_SPLIT_THRESHOLD = 4;
+
+/* default multiplication thresholds, in limbs */
+big_integer::multiplication_thresholds big_integer::_multiplicationThresholds = {32, 160, 6000};
+
+/* default parallelism: a single thread, products split across threads from 2000 limbs */
+big_integer::multiplication_parallelism big_integer::_multiplicationParallelism = {1, 2000};
+
+/* a schoolbook square does half the products of a multiplication, so squares switch to
+ * karatsuba at this percentage of the karatsuba multiplication threshold */
+const size_t SQUARE_KARATSUBA_PERCENT = 150;
+
+/* divisors from this length (in limbs) are divided recursively, also the length below
+ * which the recursion falls back to knuth's algorithm */
+const size_t BURNIKEL_ZIEGLER_THRESHOLD = 60;
+
+/* the recursive division is used when the quotient is at least this long (in limbs) */
+const size_t BURNIKEL_ZIEGLER_OFFSET = 40;
+
+/* number of primes the number theoretic transform works with */
+const int NTT_PRIME_COUNT = 3;
+
+/* butterflies per task when a transform stage is split across threads, a power of 2 */
+const size_t NTT_PARALLEL_CHUNK = 8192;
+
+/**
+ * a prime below 2^62 of the form c * 2^50 + 1 for the number theoretic transform,
+ * with the constants for montgomery multiplication modulo the prime.
+ * values in montgomery form are kept as x * 2^64 mod the prime.
+ * @class ntt_prime
+ */
+class ntt_prime
+{
+public:
+    /* the prime */
+    std::uint64_t modulus;
+
+    /* a primitive root modulo the prime */
+    std::uint64_t root;
+
+    /**
+     * constructor, precompute the montgomery constants
+     * @param prime the prime
+     * @param primitiveRoot a primitive root modulo the prime
+     */
+    ntt_prime(std::uint64_t prime, std::uint64_t primitiveRoot) : modulus(prime), root(primitiveRoot)
+    {
+        // newton iteration for prime^-1 mod 2^64, every step doubles the correct bits
+        std::uint64_t inverse = prime;
+        for (int i = 0; i < 6; i++)
+        {
+            inverse *= 2 - prime * inverse;
+        }
+        _negInverse = -inverse;
+        dlimb_t rMod = (dlimb_t(1) << LIMB_BITS) % prime;
+        _r2 = std::uint64_t(rMod * rMod % prime);
+    }
+
+    /**
+     * montgomery reduction of a product of two values below the prime
+     * @param value the product
+     * @return value * 2^-64 mod prime
+     */
+    std::uint64_t reduce(dlimb_t value) const
+    {
+        std::uint64_t m = std::uint64_t(value) * _negInverse;
+        std::uint64_t t = std::uint64_t((value + dlimb_t(m) * modulus) >> LIMB_BITS);
+        return t >= modulus ? t - modulus : t;
+    }
+
+    /**
+     * montgomery multiplication
+     * @param a a value below the prime
+     * @param b a value below the prime
+     * @return a * b * 2^-64 mod prime
+     */
+    std::uint64_t multiply(std::uint64_t a, std::uint64_t b) const
+    {
+        return reduce(dlimb_t(a) * b);
+    }
+
+    /**
+     * modular addition
+     * @param a a value below the prime
+     * @param b a value below the prime
+     * @return a + b mod prime
+     */
+    std::uint64_t add(std::uint64_t a, std::uint64_t b) const
+    {
+        std::uint64_t sum = a + b;
+        return sum >= modulus ? sum - modulus : sum;
+    }
+
+    /**
+     * modular substraction
+     * @param a a value below the prime
+     * @param b a value below the prime
+     * @return a - b mod prime
+     */
+    std::uint64_t substract(std::uint64_t a, std::uint64_t b) const
+    {
+        return a >= b ? a - b : a + modulus - b;
+    }
+
+    /**
+     * convert any word into montgomery form
+     * @param a a word
+     * @return a * 2^64 mod prime
+     */
+    std::uint64_t toMontgomery(std::uint64_t a) const
+    {
+        return multiply(a % modulus, _r2);
+    }
+
+    /**
+     * convert a value out of montgomery form
+     * @param a a value in montgomery form
+     * @return a * 2^-64 mod prime
+     */
+    std::uint64_t fromMontgomery(std::uint64_t a) const
+    {
+        return reduce(a);
+    }
+
+    /**
+     * power of a value in montgomery form
+     * @param base a value in montgomery form
+     * @param exponent the exponent
+     * @return base^exponent in montgomery form
+     */
+    std::uint64_t power(std::uint64_t base, std::uint64_t exponent) const
+    {
+        std::uint64_t res = toMontgomery(1);
+        for (; exponent != 0; exponent >>= 1)
+        {
+            if (exponent & 1)
+            {
+                res = multiply(res, base);
+            }
+            base = multiply(base, base);
+        }
+        return res;
+    }
+
+private:
+    /* -prime^-1 mod 2^64 */
+    std::uint64_t _negInverse;
+
+    /* 2^128 mod prime */
+    std::uint64_t _r2;
+};
+
+/* the transform primes, their product exceeds 2^185 so a convolution of up to 2^57 limb
+ * products can be recombined exactly */
+const ntt_prime NTT_PRIMES[NTT_PRIME_COUNT] = {ntt_prime(4601552919265804289ULL, 3),
+                                               ntt_prime(4546383823830515713ULL, 10),
+                                               ntt_prime(4522739925786820609ULL, 37)};
+
+/* the queue of the task pool owned by this thread, 0 (the shared one) outside the pool */
+static thread_local size_t ownTaskQueue = 0;
+
+/**
+ * a fork join pool of worker threads for parallel multiplication. every worker owns a deque
+ * of tasks: it pushes and pops its own tasks at the back and, once it runs dry, steals from
+ * the front of the others, where the oldest and largest splits wait. threads outside the
+ * pool share queue 0. a thread waiting for its tasks runs queued tasks meanwhile, so nested
+ * splits never leave a thread blocked.
+ * @class task_pool
+ */
+class task_pool
+{
+public:
+    /**
+     * constructor, start the workers
+     * @param threads number of threads working on tasks, the calling threads included
+     */
+    explicit task_pool(unsigned int threads) : _queues(threads), _queued(0), _stop(false)
+    {
+        for (size_t i = 1; i < threads; i++)
+        {
+            _workers.emplace_back(&task_pool::_work, this, i);
+        }
+    }
+
+    /**
+     * destructor, stop and join the workers
+     */
+    ~task_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (std::thread &worker : _workers)
+        {
+            worker.join();
+        }
+    }
+
+    task_pool(const task_pool &) = delete;
+
+    task_pool &operator=(const task_pool &) = delete;
+
+    /**
+     * queue a task on the queue of this thread
+     * @param work the task
+     * @param pending counter of the unfinished tasks of the caller, the task decrements it
+     * when it is done
+     */
+    void submit(std::function<void()> work, std::atomic<size_t> &pending)
+    {
+        pending++;
+        task_queue &queue = _queues[ownTaskQueue];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(queued_task{std::move(work), &pending});
+        }
+        _queued++;
+        // a worker checks _queued under the sleep mutex before it sleeps
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+        }
+        _wake.notify_one();
+    }
+
+    /**
+     * run queued tasks until pending drops to 0
+     * @param pending counter of the unfinished tasks of the caller
+     */
+    void wait(std::atomic<size_t> &pending)
+    {
+        while (pending.load() != 0)
+        {
+            if (!_runOne())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    /**
+     * a task and the counter it decrements
+     * @struct queued_task
+     */
+    struct queued_task
+    {
+        /* the work */
+        std::function<void()> work;
+        /* unfinished tasks of the submitter */
+        std::atomic<size_t> *pending;
+    };
+
+    /**
+     * the deque of a thread
+     * @struct task_queue
+     */
+    struct task_queue
+    {
+        /* guards tasks */
+        std::mutex mutex;
+        /* the waiting tasks, the newest at the back */
+        std::deque<queued_task> tasks;
+    };
+
+    /* one queue per thread, 0 for the callers */
+    std::vector<task_queue> _queues;
+
+    /* the worker threads */
+    std::vector<std::thread> _workers;
+
+    /* number of tasks waiting in all the queues */
+    std::atomic<size_t> _queued;
+
+    /* idle workers sleep on _wake under _sleepMutex */
+    std::mutex _sleepMutex;
+    std::condition_variable _wake;
+
+    /* set once to stop the workers, guarded by _sleepMutex */
+    bool _stop;
+
+    /**
+    * run a single task, the newest of the own queue or else the oldest of another queue
+    * @return false if every queue was empty
+    */
+    bool _runOne()
+    {
+        queued_task task;
+        bool found = false;
+        size_t count = _queues.size();
+        for (size_t i = 0; i < count && !found; i++)
+        {
+            task_queue &queue = _queues[(ownTaskQueue + i) % count];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+            {
+                continue;
+            }
+            if (i == 0)
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            found = true;
+        }
+        if (!found)
+        {
+            return false;
+        }
+        _queued--;
+        task.work();
+        task.pending->fetch_sub(1);
+        return true;
+    }
+
+    /**
+    * the loop of a worker thread
+    * @param index the queue of the worker
+    */
+    void _work(size_t index)
+    {
+        ownTaskQueue = index;
+        while (true)
+        {
+            if (_runOne())
+            {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _wake.wait(lock, [this] { return _stop || _queued.load() != 0; });
+            if (_stop)
+            {
+                return;
+            }
+        }
+    }
+};
+
+/* the pool of parallel multiplication, null while it runs on a single thread */
+static std::unique_ptr<task_pool> multiplicationPool;
+
+/**
+ * run body(0), ..., body(count - 1), as tasks of the multiplication pool when parallel is
+ * true. the calling thread runs the last one itself and returns once all are done.
+ * @param parallel false to run them in order on the calling thread
+ * @param count number of calls
+ * @param body the function to call with every index
+ */
+template<class Body>
+static void parallelFor(bool parallel, size_t count, const Body &body)
+{
+    if (!parallel || multiplicationPool == nullptr || count < 2)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            body(i);
+        }
+        return;
+    }
+    std::atomic<size_t> pending(0);
+    for (size_t i = 0; i + 1 < count; i++)
+    {
+        multiplicationPool->submit([&body, i] { body(i); }, pending);
+    }
+    body(count - 1);
+    multiplicationPool->wait(pending);
+}
+
+/**
+ * the butterflies [first, first + count) of a transform stage, in the order of the stage.
+ * count must be a multiple of half or divide it, both are powers of 2.
+ * @param values the values
+ * @param stageTwiddles the twiddle factors of the stage
+ * @param half half the length of the blocks of the stage
+ * @param first the first butterfly
+ * @param count number of butterflies
+ * @param field the prime to transform modulo
+ */
+static void nttButterflies(std::uint64_t *values, const std::uint64_t *stageTwiddles,
+                           size_t half, size_t first, size_t count, const ntt_prime &field)
+{
+    const ntt_prime prime = field;
+    size_t begin = first % half, span = std::min(count, half);
+    for (size_t pair = first; pair < first + count; pair += span)
+    {
+        std::uint64_t *low = values + pair / half * 2 * half, *high = low + half;
+        for (size_t j = begin; j < begin + span; j++)
+        {
+            std::uint64_t u = low[j];
+            std::uint64_t v = prime.multiply(high[j], stageTwiddles[j]);
+            low[j] = prime.add(u, v);
+            high[j] = prime.substract(u, v);
+        }
+    }
+}
+
+/**
+ * in place number theoretic transform of values in montgomery form
+ * @param values the values, their count must be a power of 2
+ * @param field the prime to transform modulo
+ * @param inverse true for the inverse transform (including the division by the length)
+ * @param parallel true to split the stages across the multiplication pool
+ */
+static void nttTransform(std::vector<std::uint64_t> &values, const ntt_prime &field, bool inverse,
+                         bool parallel)
+{
+    // a local copy lets the compiler keep the constants in registers while values are written
+    const ntt_prime prime = field;
+    size_t n = values.size();
+    // bit reversal permutation
+    for (size_t i = 1, j = 0; i < n; i++)
+    {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j)
+        {
+            std::swap(values[i], values[j]);
+        }
+    }
+    // the twiddle factors of the stage of length len are kept at [len / 2, len)
+    std::vector<std::uint64_t> twiddles(std::max(n, size_t(2)));
+    for (size_t half = 1; half < n; half <<= 1)
+    {
+        std::uint64_t unit = prime.power(prime.toMontgomery(prime.root),
+                                         (prime.modulus - 1) / (2 * half));
+        if (inverse)
+        {
+            unit = prime.power(unit, prime.modulus - 2);
+        }
+        twiddles[half] = prime.toMontgomery(1);
+        for (size_t j = 1; j < half; j++)
+        {
+            twiddles[half + j] = prime.multiply(twiddles[half + j - 1], unit);
+        }
+    }
+    // butterflies, a stage has n / 2 of them
+    size_t chunk = parallel ? std::min(n / 2, NTT_PARALLEL_CHUNK) : n / 2;
+    for (size_t half = 1; half < n; half <<= 1)
+    {
+        const std::uint64_t *stageTwiddles = twiddles.data() + half;
+        parallelFor(parallel, n / 2 / std::max(chunk, size_t(1)), [&](size_t i)
+        {
+            nttButterflies(values.data(), stageTwiddles, half, i * chunk, chunk, prime);
+        });
+    }
+    if (inverse)
+    {
+        std::uint64_t scale = prime.power(prime.toMontgomery(n), prime.modulus - 2);
+        for (size_t i = 0; i < n; i++)
+        {
+            values[i] = prime.multiply(values[i], scale);
+        }
+    }
+}
+
+/**
+ * read a magnitude of at most two limbs as a native integer
+ * @param limbs a magnitude that fits the inline storage
+ * @return the magnitude
+ */
+static dlimb_t toNative(const limb_vector &limbs)
+{
+    dlimb_t value = 0;
+    for (size_t i = limbs.size(); i > 0; i--)
+    {
+        value = (value << LIMB_BITS) | limbs[i - 1];
+    }
+    return value;
+}
+
+/**
+ * store a native integer as a normalized magnitude, which stays inline
+ * @param limbs output magnitude
+ * @param value the value
+ */
+static void fromNative(limb_vector &limbs, dlimb_t value)
+{
+    limbs.clear();
+    for (; value != 0; value >>= LIMB_BITS)
+    {
+        limbs.push_back(big_integer::limb_t(value));
+    }
+}
+
+/**
+ * the reciprocal of a normalized divisor used by divideTwoByOne
+ * @param divisor a limb with its top bit set
+ * @return floor((2^128 - 1) / divisor) - 2^64
+ */
+static big_integer::limb_t reciprocalOf(big_integer::limb_t divisor)
+{
+    // 2^128 - 1 - divisor * 2^64 has the complement of divisor as its high limb
+    dlimb_t numerator = (dlimb_t(~divisor) << LIMB_BITS) | ~big_integer::limb_t(0);
+    return big_integer::limb_t(numerator / divisor);
+}
+
+/**
+ * divide a two limb number by a normalized limb with a multiplication by its reciprocal
+ * (moller and granlund, "improved division by invariant integers")
+ * @param high the high limb, below divisor
+ * @param low the low limb
+ * @param divisor a limb with its top bit set
+ * @param reciprocal reciprocalOf(divisor)
+ * @param remainder output, (high * 2^64 + low) % divisor
+ * @return (high * 2^64 + low) / divisor
+ */
+static big_integer::limb_t divideTwoByOne(big_integer::limb_t high, big_integer::limb_t low,
+                                          big_integer::limb_t divisor,
+                                          big_integer::limb_t reciprocal,
+                                          big_integer::limb_t &remainder)
+{
+    dlimb_t estimate = dlimb_t(reciprocal) * high + ((dlimb_t(high) << LIMB_BITS) | low);
+    big_integer::limb_t quotient = big_integer::limb_t(estimate >> LIMB_BITS) + 1;
+    big_integer::limb_t rest = low - quotient * divisor;
+    // the estimate is at most one too large or one too small
+    if (rest > big_integer::limb_t(estimate))
+    {
+        quotient--;
+        rest += divisor;
+    }
+    if (rest >= divisor)
+    {
+        quotient++;
+        rest -= divisor;
+    }
+    remainder = rest;
+    return quotient;
+}
+
+/**
+ * multiply two words and fold the 128 bit product into one word
+ * @param word1 a word
+ * @param word2 a word
+ * @return the low half of the product xor its high half
+ */
+static std::uint64_t hashMix(std::uint64_t word1, std::uint64_t word2)
+{
+    dlimb_t product = dlimb_t(word1) * word2;
+    return std::uint64_t(product) ^ std::uint64_t(product >> LIMB_BITS);
+}
+
+/**
+ * @param value a non zero value
+ * @return the number of trailing zero bits of value
+ */
+static int trailingZeros(dlimb_t value)
+{
+    std::uint64_t low = std::uint64_t(value);
+    if (low != 0)
+    {
+        return __builtin_ctzll(low);
+    }
+    return LIMB_BITS + __builtin_ctzll(std::uint64_t(value >> LIMB_BITS));
+}
+
+/**
+ * binary gcd, only shifts and substractions
+ * @param num1 a value
+ * @param num2 a value
+ * @return gcd(num1, num2)
+ */
+static dlimb_t binaryGcd(dlimb_t num1, dlimb_t num2)
+{
+    if (num1 == 0 || num2 == 0)
+    {
+        return num1 | num2;
+    }
+    int shift = trailingZeros(num1 | num2);
+    num1 >>= trailingZeros(num1);
+    while (num2 != 0)
+    {
+        // both odd, the difference is even and its odd part replaces the larger one
+        num2 >>= trailingZeros(num2);
+        if (num1 > num2)
+        {
+            std::swap(num1, num2);
+        }
+        num2 -= num1;
+    }
+    return num1 << shift;
+}
+
+/**
+ * @param base a word
+ * @param exponent the exponent
+ * @param bound a word
+ * @return true if base^exponent <= bound
+ */
+static bool powerAtMost(std::uint64_t base, unsigned int exponent, std::uint64_t bound)
+{
+    if (base <= 1)
+    {
+        return exponent == 0 || base <= bound;
+    }
+    // the power stays below 2^64 before every multiplication, so it never overflows
+    dlimb_t power = 1;
+    for (unsigned int i = 0; i < exponent; i++)
+    {
+        power *= base;
+        if (power > bound)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * k-th root of a word, a floating point estimate corrected by exact powers
+ * @param num a word
+ * @param k the degree of the root, not 0
+ * @return floor(num^(1/k))
+ */
+static std::uint64_t nativeRoot(std::uint64_t num, unsigned int k)
+{
+    if (k == 1 || num <= 1)
+    {
+        return num;
+    }
+    std::uint64_t root = std::uint64_t(std::pow(double(num), 1.0 / k));
+    while (root > 0 && !powerAtMost(root, k, num))
+    {
+        root--;
+    }
+    while (powerAtMost(root + 1, k, num))
+    {
+        root++;
+    }
+    return root;
+}
+
+/**
+ * @param residue a residue below modulus
+ * @param modulus a small modulus
+ * @return true if residue is a square modulo modulus
+ */
+static bool isSquareResidue(std::uint64_t residue, std::uint64_t modulus)
+{
+    for (std::uint64_t i = 0; i < modulus; i++)
+    {
+        if (i * i % modulus == residue)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @param num a small number
+ * @return true if num is prime
+ */
+static bool isSmallPrime(unsigned int num)
+{
+    if (num < 2)
+    {
+        return false;
+    }
+    for (unsigned int i = 2; i * i <= num; i++)
+    {
+        if (num % i == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @param base a residue below modulus
+ * @param exponent the exponent
+ * @param modulus a modulus below 2^32
+ * @return base^exponent mod modulus
+ */
+static std::uint64_t powerModWord(std::uint64_t base, std::uint64_t exponent,
+                                  std::uint64_t modulus)
+{
+    std::uint64_t res = 1 % modulus;
+    for (; exponent != 0; exponent >>= 1)
+    {
+        if (exponent & 1)
+        {
+            res = res * base % modulus;
+        }
+        base = base * base % modulus;
+    }
+    return res;
+}
+
+/**
+ * the k-th root modulo 2^64 of an odd word. for an odd k, x -> x^k permutes the odd residues,
+ * and raising to k^-1 mod 2^62 (the exponent of their group) undoes it
+ * @param num an odd word
+ * @param k an odd exponent
+ * @return the only odd r below 2^64 with r^k = num mod 2^64
+ */
+static std::uint64_t oddRootModWord(std::uint64_t num, std::uint64_t k)
+{
+    // newton doubles the correct low bits of the inverse, k * k = 1 mod 8 gives the first 3
+    std::uint64_t inverse = k;
+    for (int i = 0; i < 5; i++)
+    {
+        inverse *= 2 - k * inverse;
+    }
+    std::uint64_t exponent = inverse & ((1ULL << 62) - 1), root = 1;
+    for (; exponent != 0; exponent >>= 1)
+    {
+        if (exponent & 1)
+        {
+            root *= num;
+        }
+        num *= num;
+    }
+    return root;
+}
+
+/**
+ * rule out p-th powers by their residues modulo primes q = 1 mod p, where only one in p of
+ * the non zero residues is a p-th power
+ * @param limbs a magnitude
+ * @param p an odd prime
+ * @return false if the magnitude is certainly not a p-th power
+ */
+static bool passesPowerResidues(const limb_vector &limbs, std::uint64_t p)
+{
+    unsigned int tested = 0;
+    for (std::uint64_t q = 2 * p + 1; tested < POWER_FILTER_MODULI && q < POWER_FILTER_LIMIT;
+         q += 2 * p)
+    {
+        if (!isSmallPrime((unsigned int) q))
+        {
+            continue;
+        }
+        tested++;
+        std::uint64_t residue = 0;
+        for (size_t i = limbs.size(); i > 0; i--)
+        {
+            residue = std::uint64_t(((dlimb_t(residue) << LIMB_BITS) | limbs[i - 1]) % q);
+        }
+        if (residue != 0 && powerModWord(residue, (q - 1) / p, q) != 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @param limbs a non zero magnitude
+ * @return log2 of the magnitude, from its two leading limbs
+ */
+static double leadingLog2(const limb_vector &limbs)
+{
+    size_t len = limbs.size();
+    double leading = double(limbs[len - 1]);
+    if (len > 1)
+    {
+        leading = leading * WORD_RANGE + double(limbs[len - 2]);
+    }
+    return std::log2(leading) + double(LIMB_BITS) * double(len > 1 ? len - 2 : 0);
+}
+
+/**
+ * call a function with every prime up to n in increasing order, sieving the odd numbers
+ * @param n the bound
+ * @param visit the function
+ */
+template<class Visit>
+static void forEachPrime(std::uint64_t n, const Visit &visit)
+{
+    if (n < 2)
+    {
+        return;
+    }
+    visit(std::uint64_t(2));
+    // index i stands for the odd number 2 * i + 1
+    std::vector<bool> composite(size_t((n - 1) / 2 + 1), false);
+    for (size_t i = 1; i < composite.size(); i++)
+    {
+        if (composite[i])
+        {
+            continue;
+        }
+        std::uint64_t prime = 2 * i + 1;
+        visit(prime);
+        if (prime <= n / prime)
+        {
+            for (std::uint64_t j = prime * prime / 2; j < composite.size(); j += prime)
+            {
+                composite[j] = true;
+            }
+        }
+    }
+}
+
+/**
+ * the leaves of a product tree of word sized factors: consecutive factors share a limb as
+ * long as their product fits, so the tree starts from full limbs instead of tiny numbers
+ * @class packed_factors
+ */
+class packed_factors
+{
+public:
+    /**
+     * constructor, no factors
+     */
+    packed_factors() : _word(1)
+    {};
+
+    /**
+     * add a factor
+     * @param factor a non zero factor
+     */
+    void push(std::uint64_t factor)
+    {
+        if (_word > UINT64_MAX / factor)
+        {
+            _leaves.emplace_back(_word);
+            _word = 1;
+        }
+        _word *= factor;
+    }
+
+    /**
+     * @return the product of all the factors
+     */
+    big_integer product()
+    {
+        _leaves.emplace_back(_word);
+        _word = 1;
+        return big_integer::product(std::make_move_iterator(_leaves.begin()),
+                                    std::make_move_iterator(_leaves.end()));
+    }
+
+private:
+    /* the full limbs so far */
+    std::vector<big_integer> _leaves;
+
+    /* the product of the factors after the last leaf */
+    std::uint64_t _word;
+};
+
+/**
+ * store limbs as 8 little endian bytes each, at any alignment
+ * @param bytes output
+ * @param limbs the limbs
+ * @param count number of limbs
+ */
+static void writeLittleEndian(unsigned char *bytes, const std::uint64_t *limbs, size_t count)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::memcpy(bytes, limbs, count * SERIAL_LIMB_BYTES);
+#else
+    for (size_t i = 0; i < count; i++)
+    {
+        for (size_t j = 0; j < SERIAL_LIMB_BYTES; j++)
+        {
+            *bytes++ = static_cast<unsigned char>(limbs[i] >> (8 * j));
+        }
+    }
+#endif
+}
+
+/* a carry chain kernel: result = num1 + num2 + carry (or num1 - num2 - borrow) over len limbs,
+ * returns the carry (or borrow) out. result may alias num1 or num2. */
+typedef std::uint64_t (*carry_kernel)(std::uint64_t *result, const std::uint64_t *num1,
+                                      const std::uint64_t *num2, size_t len, std::uint64_t carry);
+
+/**
+ * add with carry, one limb at a time. on x86-64 the chain is kept in the carry flag.
+ * @param result output of len limbs
+ * @param num1 a number
+ * @param num2 a number
+ * @param len length of both numbers
+ * @param carry the carry in, 0 or 1
+ * @return the carry out
+ */
+static std::uint64_t addCarryScalar(std::uint64_t *result, const std::uint64_t *num1,
+                                    const std::uint64_t *num2, size_t len, std::uint64_t carry)
+{
+#if defined(__x86_64__) && !defined(BIG_INTEGER_PORTABLE)
+    unsigned char flag = (unsigned char) carry;
+    unsigned long long *out = reinterpret_cast<unsigned long long *>(result);
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        flag = _addcarry_u64(flag, num1[i], num2[i], out + i);
+        flag = _addcarry_u64(flag, num1[i + 1], num2[i + 1], out + i + 1);
+        flag = _addcarry_u64(flag, num1[i + 2], num2[i + 2], out + i + 2);
+        flag = _addcarry_u64(flag, num1[i + 3], num2[i + 3], out + i + 3);
+    }
+    for (; i < len; i++)
+    {
+        flag = _addcarry_u64(flag, num1[i], num2[i], out + i);
+    }
+    return flag;
+#else
+    for (size_t i = 0; i < len; i++)
+    {
+        std::uint64_t sum;
+        std::uint64_t overflow1 = __builtin_add_overflow(num1[i], num2[i], &sum);
+        std::uint64_t overflow2 = __builtin_add_overflow(sum, carry, &result[i]);
+        carry = overflow1 | overflow2;
+    }
+    return carry;
+#endif
+}
+
+/**
+ * substract with borrow, one limb at a time. on x86-64 the chain is kept in the carry flag.
+ * @param result output of len limbs
+ * @param num1 a number
+ * @param num2 a number
+ * @param len length of both numbers
+ * @param borrow the borrow in, 0 or 1
+ * @return the borrow out
+ */
+static std::uint64_t substractBorrowScalar(std::uint64_t *result, const std::uint64_t *num1,
+                                           const std::uint64_t *num2, size_t len,
+                                           std::uint64_t borrow)
+{
+#if defined(__x86_64__) && !defined(BIG_INTEGER_PORTABLE)
+    unsigned char flag = (unsigned char) borrow;
+    unsigned long long *out = reinterpret_cast<unsigned long long *>(result);
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        flag = _subborrow_u64(flag, num1[i], num2[i], out + i);
+        flag = _subborrow_u64(flag, num1[i + 1], num2[i + 1], out + i + 1);
+        flag = _subborrow_u64(flag, num1[i + 2], num2[i + 2], out + i + 2);
+        flag = _subborrow_u64(flag, num1[i + 3], num2[i + 3], out + i + 3);
+    }
+    for (; i < len; i++)
+    {
+        flag = _subborrow_u64(flag, num1[i], num2[i], out + i);
+    }
+    return flag;
+#else
+    for (size_t i = 0; i < len; i++)
+    {
+        std::uint64_t diff;
+        std::uint64_t underflow1 = __builtin_sub_overflow(num1[i], num2[i], &diff);
+        std::uint64_t underflow2 = __builtin_sub_overflow(diff, borrow, &result[i]);
+        borrow = underflow1 | underflow2;
+    }
+    return borrow;
+#endif
+}
+
+#if defined(__x86_64__) && !defined(BIG_INTEGER_PORTABLE)
+/**
+ * add with carry 16 limbs at a time with avx-512 carry lookahead: the lanes are added
+ * independently, a lane generates a carry when its sum wrapped and passes one on when its
+ * sum is all ones, and the carries into all 16 lanes are resolved at once by adding the
+ * masks as integers, ((generate << 1 | carry) + propagate) ^ propagate.
+ * @param result output of len limbs
+ * @param num1 a number
+ * @param num2 a number
+ * @param len length of both numbers
+ * @param carry the carry in, 0 or 1
+ * @return the carry out
+ */
+__attribute__((target("avx512f")))
+static std::uint64_t addCarryAvx512(std::uint64_t *result, const std::uint64_t *num1,
+                                    const std::uint64_t *num2, size_t len, std::uint64_t carry)
+{
+    const __m512i ones = _mm512_set1_epi64(-1);
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m512i low1 = _mm512_loadu_si512(num1 + i), high1 = _mm512_loadu_si512(num1 + i + 8);
+        __m512i low2 = _mm512_loadu_si512(num2 + i), high2 = _mm512_loadu_si512(num2 + i + 8);
+        __m512i low = _mm512_add_epi64(low1, low2), high = _mm512_add_epi64(high1, high2);
+        unsigned int generate = unsigned(_mm512_cmplt_epu64_mask(low, low1)) |
+                                unsigned(_mm512_cmplt_epu64_mask(high, high1)) << 8;
+        unsigned int propagate = unsigned(_mm512_cmpeq_epi64_mask(low, ones)) |
+                                 unsigned(_mm512_cmpeq_epi64_mask(high, ones)) << 8;
+        unsigned int carries = (((generate << 1) | unsigned(carry)) + propagate) ^ propagate;
+        low = _mm512_mask_sub_epi64(low, __mmask8(carries), low, ones);
+        high = _mm512_mask_sub_epi64(high, __mmask8(carries >> 8), high, ones);
+        _mm512_storeu_si512(result + i, low);
+        _mm512_storeu_si512(result + i + 8, high);
+        carry = (carries >> 16) & 1;
+    }
+    return addCarryScalar(result + i, num1 + i, num2 + i, len - i, carry);
+}
+
+/**
+ * substract with borrow 16 limbs at a time, the borrow lookahead of addCarryAvx512: a lane
+ * generates a borrow when num1 < num2 and passes one on when its difference is 0
+ * @param result output of len limbs
+ * @param num1 a number
+ * @param num2 a number
+ * @param len length of both numbers
+ * @param borrow the borrow in, 0 or 1
+ * @return the borrow out
+ */
+__attribute__((target("avx512f")))
+static std::uint64_t substractBorrowAvx512(std::uint64_t *result, const std::uint64_t *num1,
+                                           const std::uint64_t *num2, size_t len,
+                                           std::uint64_t borrow)
+{
+    const __m512i ones = _mm512_set1_epi64(-1), zero = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m512i low1 = _mm512_loadu_si512(num1 + i), high1 = _mm512_loadu_si512(num1 + i + 8);
+        __m512i low2 = _mm512_loadu_si512(num2 + i), high2 = _mm512_loadu_si512(num2 + i + 8);
+        __m512i low = _mm512_sub_epi64(low1, low2), high = _mm512_sub_epi64(high1, high2);
+        unsigned int generate = unsigned(_mm512_cmplt_epu64_mask(low1, low2)) |
+                                unsigned(_mm512_cmplt_epu64_mask(high1, high2)) << 8;
+        unsigned int propagate = unsigned(_mm512_cmpeq_epi64_mask(low, zero)) |
+                                 unsigned(_mm512_cmpeq_epi64_mask(high, zero)) << 8;
+        unsigned int borrows = (((generate << 1) | unsigned(borrow)) + propagate) ^ propagate;
+        low = _mm512_mask_add_epi64(low, __mmask8(borrows), low, ones);
+        high = _mm512_mask_add_epi64(high, __mmask8(borrows >> 8), high, ones);
+        _mm512_storeu_si512(result + i, low);
+        _mm512_storeu_si512(result + i + 8, high);
+        borrow = (borrows >> 16) & 1;
+    }
+    return substractBorrowScalar(result + i, num1 + i, num2 + i, len - i, borrow);
+}
+#endif
+
+/**
+ * @return the fastest addition kernel the processor supports, picked on the first call
+ */
+static carry_kernel addKernel()
+{
+#if defined(__x86_64__) && !defined(BIG_INTEGER_PORTABLE)
+    static const carry_kernel kernel = __builtin_cpu_supports("avx512f") ? addCarryAvx512
+                                                                         : addCarryScalar;
+    return kernel;
+#else
+    return addCarryScalar;
+#endif
+}
+
+/**
+ * @return the fastest substraction kernel the processor supports, picked on the first call
+ */
+static carry_kernel substractKernel()
+{
+#if defined(__x86_64__) && !defined(BIG_INTEGER_PORTABLE)
+    static const carry_kernel kernel = __builtin_cpu_supports("avx512f") ? substractBorrowAvx512
+                                                                         : substractBorrowScalar;
+    return kernel;
+#else
+    return substractBorrowScalar;
+#endif
+}
+
+/**
+ * get an integer and construct a big number
+ * @param number a number
+ */
+big_integer::big_integer(int number) : _hash(0)
+{
+    this->_isPositive = number >= 0;
+    // widen before negating so the smallest int does not overflow
+    long long wide = number;
+    limb_t magnitude = wide < 0 ? limb_t(-wide) : limb_t(wide);
+    if (magnitude != 0)
+    {
+        this->_limbs.push_back(magnitude);
+    }
+}
+
+/**
+ * construct a big number out of a signed 128 bit integer
+ * @param number a number
+ */
+big_integer::big_integer(__int128 number) : _isPositive(number >= 0), _hash(0)
+{
+    fromNative(_limbs, number < 0 ? dlimb_t(0) - dlimb_t(number) : dlimb_t(number));
+}
+
+/**
+ * construct a big number out of an unsigned 128 bit integer
+ * @param number a number
+ */
+big_integer::big_integer(unsigned __int128 number) : _isPositive(true), _hash(0)
+{
+    fromNative(_limbs, number);
+}
+
+/**
+ * construct a big integer out of a big integer
+ * @param bigNum an integer
+ */
+big_integer::big_integer(const big_integer &other)
+        : _limbs(other._limbs), _isPositive(other._isPositive),
+          _hash(other._hash.load(std::memory_order_relaxed))
+{
+}
+
+/**
+ * move constructor, takes the limbs of bigNum and leaves it 0
+ * @param bigNum an integer
+ */
+big_integer::big_integer(big_integer &&other) noexcept
+        : _limbs(std::move(other._limbs)), _isPositive(other._isPositive),
+          _hash(other._hash.load(std::memory_order_relaxed))
+{
+    other._isPositive = true;
+    other._resetHash();
+}
+
+/**
+ * convert to a signed 128 bit integer, keeping the low 128 bits of the two's complement
+ * @return the number modulo 2^128
+ */
+big_integer::operator __int128() const
+{
+    return __int128(static_cast<unsigned __int128>(*this));
+}
+
+/**
+ * convert to an unsigned 128 bit integer, keeping the low 128 bits of the two's complement
+ * @return the number modulo 2^128
+ */
+big_integer::operator unsigned __int128() const
+{
+    dlimb_t low = 0;
+    for (size_t i = std::min(_limbs.size(), size_t(2)); i > 0; i--)
+    {
+        low = (low << LIMB_BITS) | _limbs[i - 1];
+    }
+    return _isPositive ? low : dlimb_t(0) - low;
+}
+
+/**
+ * = operator
+ * @param other the other big_integer
+ * @return this integer after copying other
+ */
+big_integer &big_integer::operator=(const big_integer &other)
+{
+    if (this != &other)
+    {
+        this->_limbs = other._limbs;
+        this->_isPositive = other._isPositive;
+        this->_hash.store(other._hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+/**
+ * move = operator, takes the limbs of other and leaves it 0
+ * @param other the other big_integer
+ * @return this integer
+ */
+big_integer &big_integer::operator=(big_integer &&other) noexcept
+{
+    if (this != &other)
+    {
+        this->_limbs = std::move(other._limbs);
+        this->_isPositive = other._isPositive;
+        this->_hash.store(other._hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other._isPositive = true;
+        other._resetHash();
+    }
+    return *this;
+}
+
+/**
+ * constructor
+ * @param number a string representation of number
+ */
+big_integer::big_integer(const string &number) : _hash(0)
+{
+    // if string len is 0 or string is "-" init with default values
+    if (number.length() == 0 || number == MINUS_STR)
+    {
+        _initDataMembers();
+        return;
+    }
+
+    // init data members
+    this->_isPositive = true;
+    unsigned long start = 0;
+    if (number[0] == MINUS_SIGN)
+    {
+        start = 1;
+        this->_isPositive = false;
+    }
+    for (unsigned long i = start; i < number.length(); i++)
+    {
+        if (number[i] < '0' || number[i] > '9')
+        {
+            _initDataMembers();
+            return;
+        }
+    }
+
+    this->_limbs = _parseDecimal(number.data() + start, number.length() - start)._limbs;
+    _normalize(_limbs);
+    _makeZeroPositive(*this);
+}
+
+
+/**
+ * init data members
+ */
+void big_integer::_initDataMembers()
+{
+    this->_limbs.clear();
+    this->_isPositive = true;
+    _resetHash();
+}
+
+/**
+ * adds this to other and return the result
+ * @param other big_integer
+ * @return this + other
+ */
+big_integer big_integer::operator+(const big_integer &other) const &
+{
+    big_integer res;
+    _addSigned(res, *this, other, false);
+    return res;
+}
+
+/**
+ * adds this expiring integer to other, reusing the storage of this
+ * @param other big_integer
+ * @return this + other
+ */
+big_integer big_integer::operator+(const big_integer &other) &&
+{
+    _addSigned(*this, *this, other, false);
+    return std::move(*this);
+}
+
+/**
+ * adds this to an expiring other, reusing the storage of other
+ * @param other big_integer
+ * @return this + other
+ */
+big_integer big_integer::operator+(big_integer &&other) const &
+{
+    _addSigned(other, *this, other, false);
+    return std::move(other);
+}
+
+/**
+ * adds two expiring integers, reusing the storage of this
+ * @param other big_integer
+ * @return this + other
+ */
+big_integer big_integer::operator+(big_integer &&other) &&
+{
+    _addSigned(*this, *this, other, false);
+    return std::move(*this);
+}
+
+/**
+ * return this - other
+ * @param other big_integer
+ * @return this - other
+ */
+big_integer big_integer::operator-(const big_integer &other) const &
+{
+    big_integer res;
+    _addSigned(res, *this, other, true);
+    return res;
+}
+
+/**
+ * substract other from this expiring integer, reusing the storage of this
+ * @param other big_integer
+ * @return this - other
+ */
+big_integer big_integer::operator-(const big_integer &other) &&
+{
+    _addSigned(*this, *this, other, true);
+    return std::move(*this);
+}
+
+/**
+ * substract an expiring other from this, reusing the storage of other
+ * @param other big_integer
+ * @return this - other
+ */
+big_integer big_integer::operator-(big_integer &&other) const &
+{
+    _addSigned(other, *this, other, true);
+    return std::move(other);
+}
+
+/**
+ * substract two expiring integers, reusing the storage of this
+ * @param other big_integer
+ * @return this - other
+ */
+big_integer big_integer::operator-(big_integer &&other) &&
+{
+    _addSigned(*this, *this, other, true);
+    return std::move(*this);
+}
+
+/**
+ * signed addition result = num1 + num2 (or num1 - num2), result may be num1 or num2
+ * so the sum is computed in place in the storage of an existing operand
+ * @param result output
+ * @param num1 big_integer
+ * @param num2 big_integer
+ * @param negate2 true to substract num2 instead of adding it
+ */
+void big_integer::_addSigned(big_integer &result, const big_integer &num1,
+                             const big_integer &num2, bool negate2)
+{
+    // read everything that is needed before result (maybe an operand) is written
+    bool positive1 = num1._isPositive, positive2 = num2._isPositive != negate2;
+    size_t len1 = num1._limbs.size(), len2 = num2._limbs.size();
+    result._resetHash();
+
+    // both fit in 128 bits, compute natively and only spill when the sum overflows
+    if (len1 <= limb_vector::INLINE_CAPACITY && len2 <= limb_vector::INLINE_CAPACITY)
+    {
+        dlimb_t value1 = toNative(num1._limbs), value2 = toNative(num2._limbs), value;
+        if (positive1 == positive2)
+        {
+            result._isPositive = positive1;
+            if (__builtin_add_overflow(value1, value2, &value))
+            {
+                result._limbs.resize(limb_vector::INLINE_CAPACITY + 1);
+                result._limbs[0] = limb_t(value);
+                result._limbs[1] = limb_t(value >> LIMB_BITS);
+                result._limbs[2] = 1;
+                return;
+            }
+        }
+        else
+        {
+            result._isPositive = value1 >= value2 ? positive1 : positive2;
+            value = value1 >= value2 ? value1 - value2 : value2 - value1;
+        }
+        fromNative(result._limbs, value);
+        result._makeZeroPositive(result);
+        return;
+    }
+
+    // if both have the same sign add the magnitudes, otherwise substract the smaller
+    // magnitude from the larger one, which keeps its sign
+    bool add = positive1 == positive2;
+    bool firstLarger = add || _compareMagnitude(num1._limbs.data(), len1, num2._limbs.data(),
+                                                len2) >= 0;
+    bool firstLonger = add ? len1 >= len2 : firstLarger;
+    size_t longLen = firstLonger ? len1 : len2, shortLen = firstLonger ? len2 : len1;
+    result._isPositive = firstLarger ? positive1 : positive2;
+    // growing result may move the storage of an aliased operand, so take pointers after it
+    result._limbs.resize(add ? longLen + 1 : longLen);
+    const limb_t *longer = firstLonger ? num1._limbs.data() : num2._limbs.data();
+    const limb_t *shorter = firstLonger ? num2._limbs.data() : num1._limbs.data();
+    if (add)
+    {
+        result._limbs[longLen] = _add(result._limbs.data(), longer, longLen, shorter, shortLen);
+    }
+    else
+    {
+        _substract(result._limbs.data(), longer, longLen, shorter, shortLen);
+    }
+    _normalize(result._limbs);
+    result._makeZeroPositive(result);
+}
+
+/**
+ * signed addition of a native word, result = num + word (or num - word), result may be num
+ * @param result output
+ * @param num big_integer
+ * @param word the native operand
+ * @param negate true to substract word instead of adding it
+ */
+void big_integer::_addWord(big_integer &result, const big_integer &num, const word_operand &word,
+                           bool negate)
+{
+    bool positive = num._isPositive, wordPositive = word.negative == negate;
+    size_t len = num._limbs.size();
+    result._resetHash();
+    if (len == 0)
+    {
+        result._limbs.assign(word.magnitude != 0 ? 1 : 0, word.magnitude);
+        result._isPositive = wordPositive || word.magnitude == 0;
+        return;
+    }
+    if (positive == wordPositive)
+    {
+        // growing result may move the storage of an aliased num, so take pointers after it
+        result._limbs.resize(len + 1);
+        result._limbs[len] = _add(result._limbs.data(), num._limbs.data(), len, &word.magnitude, 1);
+        result._isPositive = positive;
+    }
+    else if (len > 1 || num._limbs[0] >= word.magnitude)
+    {
+        result._limbs.resize(len);
+        _substract(result._limbs.data(), num._limbs.data(), len, &word.magnitude, 1);
+        result._isPositive = positive;
+    }
+    else
+    {
+        // a single limb below the word changes sign
+        result._limbs.assign(1, word.magnitude - num._limbs[0]);
+        result._isPositive = wordPositive;
+    }
+    _normalize(result._limbs);
+    result._makeZeroPositive(result);
+}
+
+/**
+ * result = num * word, result may be num
+ * @param result output
+ * @param num big_integer
+ * @param word the native operand
+ */
+void big_integer::_multiplyWord(big_integer &result, const big_integer &num,
+                                const word_operand &word)
+{
+    size_t len = num._limbs.size();
+    if (len == 0 || word.magnitude == 0)
+    {
+        result._initDataMembers();
+        return;
+    }
+    result._resetHash();
+    result._isPositive = num._isPositive != word.negative;
+    result._limbs.resize(len + 1);
+    result._limbs[len] = _multiplyAddSmall(result._limbs.data(), num._limbs.data(), len,
+                                           word.magnitude, 0);
+    _normalize(result._limbs);
+}
+
+/**
+ * divide by a native word with the semantics of divmod, the outputs may be num
+ * @param quotient output, num / word, or nullptr if not needed
+ * @param remainder output, num % word, or nullptr if not needed
+ * @param num the dividend
+ * @param word the native divisor
+ */
+void big_integer::_divideWord(big_integer *quotient, big_integer *remainder,
+                              const big_integer &num, const word_operand &word)
+{
+    // the quotient truncates and the remainder takes its sign, x / 0 and x % 0 are 0
+    bool positive = num._isPositive != word.negative;
+    size_t len = num._limbs.size();
+    limb_t rest = 0;
+    if (word.magnitude == 0)
+    {
+        len = 0;
+    }
+    if (quotient != nullptr)
+    {
+        quotient->_resetHash();
+        quotient->_limbs.resize(len);
+        rest = _divideBySmall(quotient->_limbs.data(), num._limbs.data(), len, word.magnitude);
+        _normalize(quotient->_limbs);
+        quotient->_isPositive = positive || quotient->_limbs.empty();
+    }
+    else
+    {
+        rest = _divideBySmall(nullptr, num._limbs.data(), len, word.magnitude);
+    }
+    if (remainder != nullptr)
+    {
+        remainder->_resetHash();
+        remainder->_limbs.assign(rest != 0 ? 1 : 0, rest);
+        remainder->_isPositive = positive || rest == 0;
+    }
+}
+
+/**
+ * @return the low 64 bits of the two's complement of this number
+ */
+big_integer::limb_t big_integer::_lowBits() const
+{
+    limb_t low = _limbs.empty() ? 0 : _limbs[0];
+    return _isPositive ? low : limb_t(0) - low;
+}
+
+/**
+ * multiply this to other and return the result
+ * @param other big_integer
+ * @return this * other
+ */
+big_integer big_integer::operator*(const big_integer &other) const
+{
+    big_integer res;
+    if (_limbs.empty() || other._limbs.empty())
+    {
+        return res;
+    }
+    if (this == &other)
+    {
+        return square(*this);
+    }
+    res._isPositive = _isPositive == other._isPositive;
+    // two single limbs multiply natively into the inline storage
+    if (_limbs.size() == 1 && other._limbs.size() == 1)
+    {
+        fromNative(res._limbs, dlimb_t(_limbs[0]) * other._limbs[0]);
+        return res;
+    }
+    res._limbs.resize(_limbs.size() + other._limbs.size());
+    _multiply(res._limbs.data(), _limbs.data(), _limbs.size(), other._limbs.data(),
+              other._limbs.size());
+    _normalize(res._limbs);
+    return res;
+}
+
+/**
+ * divide: this/ other
+ * @param other divisor
+ * @return this/ other
+ */
+big_integer big_integer::operator/(const big_integer &other) const
+{
+    big_integer quotient, remainder;
+    divmod(*this, other, quotient, remainder);
+    return quotient;
+}
+
+/**
+ * divide: this%other
+ * @param other divisor
+ * @return this% other
+ */
+big_integer big_integer::operator%(const big_integer &other) const
+{
+    big_integer quotient, remainder;
+    divmod(*this, other, quotient, remainder);
+    return remainder;
+}
+
+/**
+ * this function calculate (this /= other)
+ * @param other big_integer
+ * @return return this after doing (this /= other)
+ */
+big_integer &big_integer::operator/=(const big_integer &other)
+{
+    big_integer remainder;
+    divmod(*this, other, *this, remainder);
+    return *this;
+}
+
+/**
+ * apply a bitwise operation to the two's complements of two numbers, a limb at a time
+ * @param result output, may be one of the operands
+ * @param num1 a number
+ * @param num2 a number
+ * @param operation the operation on single limbs
+ */
+template<class Operation>
+void big_integer::_bitwise(big_integer &result, const big_integer &num1, const big_integer &num2,
+                           Operation operation)
+{
+    // the sign limbs tell the sign of the result, its magnitude may need a carry limb
+    limb_t sign1 = num1._isPositive ? 0 : ~limb_t(0), sign2 = num2._isPositive ? 0 : ~limb_t(0);
+    bool negative = operation(sign1, sign2) != 0;
+    const limb_vector &limbs1 = num1._limbs, &limbs2 = num2._limbs;
+    size_t len1 = limbs1.size(), len2 = limbs2.size(), len = std::max(len1, len2);
+    limb_vector res(len + 1);
+
+    // the two's complement of -m is ~(m - 1), the borrows of m - 1 run along with the limbs,
+    // and so does the carry of ~r + 1 that turns a negative result back into a magnitude
+    limb_t borrow1 = sign1 & 1, borrow2 = sign2 & 1, carry = negative ? 1 : 0;
+    for (size_t i = 0; i <= len; i++)
+    {
+        limb_t word1 = i < len1 ? limbs1[i] : 0, word2 = i < len2 ? limbs2[i] : 0;
+        borrow1 = __builtin_sub_overflow(word1, borrow1, &word1);
+        borrow2 = __builtin_sub_overflow(word2, borrow2, &word2);
+        limb_t word = operation(word1 ^ sign1, word2 ^ sign2);
+        if (negative)
+        {
+            carry = __builtin_add_overflow(~word, carry, &word);
+        }
+        res[i] = word;
+    }
+    _normalize(res);
+    result._limbs = std::move(res);
+    result._isPositive = !negative || result._limbs.empty();
+    result._resetHash();
+}
+
+/**
+ * shift left
+ * @param bits number of bits to shift
+ * @return this * 2^bits
+ */
+big_integer big_integer::operator<<(size_t bits) const
+{
+    big_integer res = _shiftedLeft(*this, bits);
+    res._isPositive = _isPositive;
+    return res;
+}
+
+/**
+ * assigns this << bits to this
+ * @param bits number of bits to shift
+ * @return this after shifting
+ */
+big_integer &big_integer::operator<<=(size_t bits)
+{
+    *this = *this << bits;
+    return *this;
+}
+
+/**
+ * arithmetic shift right, a negative number rounds towards minus infinity like its two's
+ * complement would
+ * @param bits number of bits to shift
+ * @return floor(this / 2^bits)
+ */
+big_integer big_integer::operator>>(size_t bits) const
+{
+    big_integer res = _shiftedRight(*this, bits);
+    if (!_isPositive)
+    {
+        // dropping set bits of a negative magnitude rounds it down, one more away from 0
+        if (_trailingZeroBits(_limbs.data(), _limbs.size()) < bits)
+        {
+            res += 1;
+        }
+        res._isPositive = res._limbs.empty();
+        res._resetHash();
+    }
+    return res;
+}
+
+/**
+ * assigns this >> bits to this
+ * @param bits number of bits to shift
+ * @return this after shifting
+ */
+big_integer &big_integer::operator>>=(size_t bits)
+{
+    *this = *this >> bits;
+    return *this;
+}
+
+/**
+ * bitwise and, a negative number acts as its two's complement with infinitely many
+ * leading ones, like for the rest of the bitwise operators
+ * @param other big_integer
+ * @return this & other
+ */
+big_integer big_integer::operator&(const big_integer &other) const
+{
+    big_integer res;
+    _bitwise(res, *this, other, std::bit_and<limb_t>());
+    return res;
+}
+
+/**
+ * assigns this & other to this
+ * @param other big_integer
+ * @return this after doing this & other
+ */
+big_integer &big_integer::operator&=(const big_integer &other)
+{
+    _bitwise(*this, *this, other, std::bit_and<limb_t>());
+    return *this;
+}
+
+/**
+ * bitwise or
+ * @param other big_integer
+ * @return this | other
+ */
+big_integer big_integer::operator|(const big_integer &other) const
+{
+    big_integer res;
+    _bitwise(res, *this, other, std::bit_or<limb_t>());
+    return res;
+}
+
+/**
+ * assigns this | other to this
+ * @param other big_integer
+ * @return this after doing this | other
+ */
+big_integer &big_integer::operator|=(const big_integer &other)
+{
+    _bitwise(*this, *this, other, std::bit_or<limb_t>());
+    return *this;
+}
+
+/**
+ * bitwise xor
+ * @param other big_integer
+ * @return this ^ other
+ */
+big_integer big_integer::operator^(const big_integer &other) const
+{
+    big_integer res;
+    _bitwise(res, *this, other, std::bit_xor<limb_t>());
+    return res;
+}
+
+/**
+ * assigns this ^ other to this
+ * @param other big_integer
+ * @return this after doing this ^ other
+ */
+big_integer &big_integer::operator^=(const big_integer &other)
+{
+    _bitwise(*this, *this, other, std::bit_xor<limb_t>());
+    return *this;
+}
+
+/**
+ * bitwise not
+ * @return ~this, which is -this - 1
+ */
+big_integer big_integer::operator~() const
+{
+    big_integer res(*this);
+    res._isPositive = !_isPositive || _limbs.empty();
+    res._resetHash();
+    res -= 1;
+    return res;
+}
+
+/**
+ * @return the number of bits of the magnitude, 0 for 0
+ */
+size_t big_integer::bit_length() const
+{
+    return _bitLength(_limbs.data(), _limbs.size());
+}
+
+/**
+ * @return the number of set bits of the magnitude
+ */
+size_t big_integer::popcount() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < _limbs.size(); i++)
+    {
+        count += size_t(__builtin_popcountll(_limbs[i]));
+    }
+    return count;
+}
+
+/**
+ * read a bit of the two's complement, so every bit far enough up of a negative number is 1
+ * @param index the bit, 0 is the least significant
+ * @return true if the bit is set
+ */
+bool big_integer::test_bit(size_t index) const
+{
+    bool bit = _extractBits(_limbs.data(), _limbs.size(), index, 1) != 0;
+    if (_isPositive)
+    {
+        return bit;
+    }
+    // ~(m - 1): m - 1 clears the lowest set bit of m and sets the ones below it
+    size_t lowest = _trailingZeroBits(_limbs.data(), _limbs.size());
+    return index < lowest ? false : index == lowest ? true : !bit;
+}
+
+/**
+ * divide num1 by num2 once, getting both results of operator/ and operator%
+ * @param num1 the dividend
+ * @param num2 the divisor
+ * @return the pair (num1 / num2, num1 % num2)
+ */
+std::pair<big_integer, big_integer> big_integer::divmod(const big_integer &num1,
+                                                        const big_integer &num2)
+{
+    std::pair<big_integer, big_integer> result;
+    divmod(num1, num2, result.first, result.second);
+    return result;
+}
+
+/**
+ * divide num1 by num2 once into caller provided outputs, reusing their storage.
+ * the outputs may be the inputs themselves but must be two different objects.
+ * @param num1 the dividend
+ * @param num2 the divisor
+ * @param quotient output, num1 / num2
+ * @param remainder output, num1 % num2
+ */
+void big_integer::divmod(const big_integer &num1, const big_integer &num2, big_integer &quotient,
+                         big_integer &remainder)
+{
+    // division by zero results in zero, and so does its remainder
+    if (num2._limbs.empty())
+    {
+        quotient._initDataMembers();
+        remainder._initDataMembers();
+        return;
+    }
+    if (&quotient == &num1 || &quotient == &num2 || &remainder == &num1 || &remainder == &num2)
+    {
+        big_integer quotientTemp, remainderTemp;
+        divmod(num1, num2, quotientTemp, remainderTemp);
+        quotient = std::move(quotientTemp);
+        remainder = std::move(remainderTemp);
+        return;
+    }
+    if (num1._limbs.size() <= limb_vector::INLINE_CAPACITY &&
+        num2._limbs.size() <= limb_vector::INLINE_CAPACITY)
+    {
+        dlimb_t dividend = toNative(num1._limbs), divisor = toNative(num2._limbs);
+        fromNative(quotient._limbs, dividend / divisor);
+        fromNative(remainder._limbs, dividend % divisor);
+    }
+    else
+    {
+        _divideMagnitude(num1._limbs, num2._limbs, quotient._limbs, remainder._limbs);
+    }
+    // the remainder takes the sign of the quotient
+    quotient._isPositive = num1._isPositive == num2._isPositive;
+    remainder._isPositive = quotient._isPositive;
+    quotient._makeZeroPositive(quotient);
+    remainder._makeZeroPositive(remainder);
+    quotient._resetHash();
+    remainder._resetHash();
+}
+
+/**
+ * modular exponentiation by montgomery multiplication and a sliding window over the
+ * exponent. the running time depends on the bits of the exponent, use
+ * powmod_constant_time when the exponent is secret.
+ * @param base the base, a negative base is taken as its non negative residue
+ * @param exponent the exponent, must not be negative
+ * @param modulus the modulus, its sign is ignored
+ * @return base^exponent mod |modulus| in [0, |modulus|), 0 if the modulus is 0 or the
+ * exponent is negative
+ */
+big_integer big_integer::powmod(const big_integer &base, const big_integer &exponent,
+                                const big_integer &modulus)
+{
+    return _powmod(base, exponent, modulus, false);
+}
+
+/**
+ * modular exponentiation whose sequence of operations and memory accesses depends only on
+ * the lengths of the exponent and the modulus, not on their bits. every window of the
+ * exponent costs the same squarings and one multiplication by a table entry that is read
+ * with a full masked scan. the modulus must be odd for this guarantee, an even modulus is
+ * handled by division like powmod.
+ * @param base the base, a negative base is taken as its non negative residue
+ * @param exponent the exponent, must not be negative
+ * @param modulus the modulus, its sign is ignored
+ * @return base^exponent mod |modulus| in [0, |modulus|), 0 if the modulus is 0 or the
+ * exponent is negative
+ */
+big_integer big_integer::powmod_constant_time(const big_integer &base,
+                                              const big_integer &exponent,
+                                              const big_integer &modulus)
+{
+    return _powmod(base, exponent, modulus, true);
+}
+
+/**
+ * shared body of powmod and powmod_constant_time
+ * @param base the base
+ * @param exponent the exponent
+ * @param modulus the modulus
+ * @param constantTime true to hide the bits of the exponent
+ * @return base^exponent mod |modulus|
+ */
+big_integer big_integer::_powmod(const big_integer &base, const big_integer &exponent,
+                                 const big_integer &modulus, bool constantTime)
+{
+    big_integer res;
+    const limb_vector &mod = modulus._limbs;
+    if (_powmodTrivial(exponent, mod, res))
+    {
+        return res;
+    }
+
+    limb_vector reduced;
+    _reduceNonNegative(base, mod, reduced);
+
+    if ((mod[0] & 1) != 0)
+    {
+        limb_vector rSquared;
+        limb_t inverse = _montgomeryConstants(mod, rSquared);
+        _powmodMontgomery(res._limbs, reduced, exponent._limbs, mod, rSquared, inverse,
+                          constantTime);
+    }
+    else
+    {
+        _powmodDivision(res._limbs, reduced, exponent._limbs, mod);
+    }
+    return res;
+}
+
+/**
+ * handle the exponentiations that need no multiplication
+ * @param exponent the exponent
+ * @param modulus the magnitude of the modulus
+ * @param result output, set when the power is trivial
+ * @return true if result holds the power
+ */
+bool big_integer::_powmodTrivial(const big_integer &exponent, const limb_vector &modulus,
+                                 big_integer &result)
+{
+    if (modulus.empty() || !exponent._isPositive || (modulus.size() == 1 && modulus[0] == 1))
+    {
+        result._initDataMembers();
+        return true;
+    }
+    if (exponent._limbs.empty())
+    {
+        result._initDataMembers();
+        result._limbs.push_back(1);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * compute the constants of montgomery arithmetic modulo an odd modulus
+ * @param modulus an odd modulus
+ * @param rSquared output, 2^(2 * 64 * len) mod modulus padded to the length of modulus
+ * @return the constant from _montgomeryInverse
+ */
+big_integer::limb_t big_integer::_montgomeryConstants(const limb_vector &modulus,
+                                                      limb_vector &rSquared)
+{
+    // rSquared takes numbers into montgomery form
+    size_t len = modulus.size();
+    limb_vector power(2 * len + 1), quotient;
+    power.back() = 1;
+    _divideMagnitude(power, modulus, quotient, rSquared);
+    rSquared.resize(len);
+    return _montgomeryInverse(modulus[0]);
+}
+
+/**
+ * modular exponentiation in montgomery form, all intermediate values live in one buffer
+ * @param result output, the normalized power
+ * @param base the base, already reduced below modulus
+ * @param exponent the exponent, not 0
+ * @param modulus an odd modulus
+ * @param rSquared the constant from _montgomeryConstants
+ * @param inverse the constant from _montgomeryConstants
+ * @param constantTime true for a fixed window with masked table reads
+ */
+void big_integer::_powmodMontgomery(limb_vector &result, const limb_vector &base,
+                                    const limb_vector &exponent, const limb_vector &modulus,
+                                    const limb_vector &rSquared, limb_t inverse,
+                                    bool constantTime)
+{
+    size_t len = modulus.size();
+    const limb_t *mod = modulus.data();
+
+    // the constant time ladder keeps every power 0 .. 2^window - 1, the sliding window only
+    // the odd ones
+    size_t expLen = exponent.size();
+    size_t bits = constantTime ? expLen * LIMB_BITS : _bitLength(exponent.data(), expLen);
+    size_t window = _windowBits(bits);
+    size_t entries = constantTime ? size_t(1) << window : size_t(1) << (window - 1);
+
+    // one buffer for the table, the accumulator, a selected entry, a constant, the product and
+    // the temporaries of the product
+    limb_vector scratch((entries + 3) * len + 2 * len + _multiplyScratchSize(len));
+    limb_t *table = scratch.data();
+    limb_t *acc = table + entries * len;
+    limb_t *selected = acc + len;
+    limb_t *constant = selected + len;
+    limb_t *product = constant + len;
+
+    std::copy(rSquared.begin(), rSquared.end(), constant);
+    limb_t *first = constantTime ? table + len : table;
+    std::copy(base.begin(), base.end(), first);
+    _montgomeryMultiply(first, first, constant, mod, len, inverse, product, constantTime);
+
+    if (constantTime)
+    {
+        // table[0] is 1 in montgomery form, table[k] = base^k
+        std::fill(constant, constant + len, limb_t(0));
+        constant[0] = 1;
+        _montgomeryMultiply(table, constant, rSquared.data(), mod, len, inverse, product, true);
+        for (size_t k = 2; k < entries; k++)
+        {
+            _montgomeryMultiply(table + k * len, table + (k - 1) * len, first, mod, len, inverse,
+                                product, true);
+        }
+
+        // the exponent is read in fixed windows from the top, the first may be partial
+        size_t windows = (bits + window - 1) / window;
+        for (size_t w = windows; w > 0; w--)
+        {
+            size_t start = (w - 1) * window;
+            limb_t index = _extractBits(exponent.data(), expLen, start, window);
+            if (w != windows)
+            {
+                for (size_t k = 0; k < window; k++)
+                {
+                    _montgomeryMultiply(acc, acc, acc, mod, len, inverse, product, true);
+                }
+            }
+            // read every entry and keep the wanted one through a mask
+            std::fill(selected, selected + len, limb_t(0));
+            for (size_t k = 0; k < entries; k++)
+            {
+                limb_t mask = limb_t(0) - limb_t((limb_t(k) ^ index) == 0);
+                const limb_t *entry = table + k * len;
+                for (size_t i = 0; i < len; i++)
+                {
+                    selected[i] |= entry[i] & mask;
+                }
+            }
+            if (w == windows)
+            {
+                std::copy(selected, selected + len, acc);
+            }
+            else
+            {
+                _montgomeryMultiply(acc, acc, selected, mod, len, inverse, product, true);
+            }
+        }
+    }
+    else
+    {
+        // table[k] = base^(2k + 1)
+        _montgomeryMultiply(selected, first, first, mod, len, inverse, product, false);
+        for (size_t k = 1; k < entries; k++)
+        {
+            _montgomeryMultiply(table + k * len, table + (k - 1) * len, selected, mod, len,
+                                inverse, product, false);
+        }
+
+        // scan from the top, zero bits are squarings, a one starts a window that ends in a one
+        bool started = false;
+        size_t top = bits;
+        while (top > 0)
+        {
+            size_t high = top - 1;
+            if (_extractBits(exponent.data(), expLen, high, 1) == 0)
+            {
+                _montgomeryMultiply(acc, acc, acc, mod, len, inverse, product, false);
+                top = high;
+                continue;
+            }
+            size_t low = top >= window ? top - window : 0;
+            while (_extractBits(exponent.data(), expLen, low, 1) == 0)
+            {
+                low++;
+            }
+            limb_t value = _extractBits(exponent.data(), expLen, low, top - low);
+            const limb_t *entry = table + (value >> 1) * len;
+            if (started)
+            {
+                for (size_t k = low; k < top; k++)
+                {
+                    _montgomeryMultiply(acc, acc, acc, mod, len, inverse, product, false);
+                }
+                _montgomeryMultiply(acc, acc, entry, mod, len, inverse, product, false);
+            }
+            else
+            {
+                std::copy(entry, entry + len, acc);
+                started = true;
+            }
+            top = low;
+        }
+    }
+
+    // multiplying by 1 takes the accumulator out of montgomery form
+    std::fill(constant, constant + len, limb_t(0));
+    constant[0] = 1;
+    _montgomeryMultiply(acc, acc, constant, mod, len, inverse, product, constantTime);
+    result.assign(acc, acc + len);
+    _normalize(result);
+}
+
+/**
+ * modular exponentiation reducing by division, used for even moduli
+ * @param result output, the normalized power
+ * @param base the base, already reduced below modulus
+ * @param exponent the exponent, not 0
+ * @param modulus the modulus
+ */
+void big_integer::_powmodDivision(limb_vector &result, const limb_vector &base,
+                                  const limb_vector &exponent, const limb_vector &modulus)
+{
+    // left to right binary exponentiation, the product buffer is reused for every step
+    limb_vector product, quotient;
+    result = base;
+    for (size_t bit = _bitLength(exponent.data(), exponent.size()) - 1; bit > 0; bit--)
+    {
+        if (result.empty())
+        {
+            return;
+        }
+        product.resize(2 * result.size());
+        _multiply(product.data(), result.data(), result.size(), result.data(), result.size());
+        _normalize(product);
+        _divideMagnitude(product, modulus, quotient, result);
+        if (_extractBits(exponent.data(), exponent.size(), bit - 1, 1) != 0)
+        {
+            product.resize(result.size() + base.size());
+            _multiply(product.data(), result.data(), result.size(), base.data(), base.size());
+            _normalize(product);
+            _divideMagnitude(product, modulus, quotient, result);
+        }
+    }
+}
+
+/**
+ * the window width of the exponentiation, wider windows pay off for longer exponents
+ * @param bits length of the exponent in bits
+ * @return the number of exponent bits handled per table multiplication
+ */
+size_t big_integer::_windowBits(size_t bits)
+{
+    for (size_t i = 0; i < sizeof(WINDOW_LIMITS) / sizeof(WINDOW_LIMITS[0]); i++)
+    {
+        if (bits > WINDOW_LIMITS[i])
+        {
+            return WINDOW_LIMITS_FIRST_WIDTH - i;
+        }
+    }
+    return 1;
+}
+
+/**
+ * read up to 64 bits of a number, bits past its end are 0
+ * @param num a number
+ * @param len length of num
+ * @param start index of the lowest bit
+ * @param count number of bits, at most 64
+ * @return the bits [start, start + count) of num
+ */
+big_integer::limb_t big_integer::_extractBits(const limb_t *num, size_t len, size_t start,
+                                              size_t count)
+{
+    size_t index = start / LIMB_BITS, shift = start % LIMB_BITS;
+    dlimb_t window = 0;
+    if (index < len)
+    {
+        window = num[index];
+    }
+    if (index + 1 < len)
+    {
+        window |= dlimb_t(num[index + 1]) << LIMB_BITS;
+    }
+    limb_t bits = limb_t(window >> shift);
+    return count < size_t(LIMB_BITS) ? bits & ((limb_t(1) << count) - 1) : bits;
+}
+
+/**
+ * @param modulus0 the lowest limb of an odd modulus
+ * @return -modulus^-1 mod 2^64, the constant of montgomery reduction
+ */
+big_integer::limb_t big_integer::_montgomeryInverse(limb_t modulus0)
+{
+    // an odd number is its own inverse mod 8, each newton step doubles the correct bits
+    limb_t inverse = modulus0;
+    for (int i = 0; i < 5; i++)
+    {
+        inverse *= 2 - modulus0 * inverse;
+    }
+    return limb_t(0) - inverse;
+}
+
+/**
+ * montgomery reduction, result = product / 2^(64 * len) mod modulus, without branches
+ * on the data. product must be below modulus * 2^(64 * len).
+ * @param result output of len limbs, below modulus
+ * @param product 2 * len limbs, destroyed
+ * @param modulus an odd modulus
+ * @param len length of modulus
+ * @param inverse the constant from _montgomeryInverse
+ */
+void big_integer::_montgomeryReduce(limb_t *result, limb_t *product, const limb_t *modulus,
+                                    size_t len, limb_t inverse)
+{
+    // clear one limb per step by adding a multiple of modulus, the carry of each step
+    // lands on the first limb the step did not reach
+    limb_t carry = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        limb_t rowCarry = _addMultiplyRow(product + i, modulus, len, product[i] * inverse);
+        dlimb_t top = dlimb_t(product[i + len]) + rowCarry + carry;
+        product[i + len] = limb_t(top);
+        carry = limb_t(top >> LIMB_BITS);
+    }
+    // the value is below 2 * modulus, substract modulus unless that goes negative
+    limb_t borrow = _substract(result, product + len, len, modulus, len);
+    limb_t keep = limb_t(0) - (carry | (borrow ^ 1));
+    for (size_t i = 0; i < len; i++)
+    {
+        result[i] = (result[i] & keep) | (product[len + i] & ~keep);
+    }
+}
+
+/**
+ * montgomery multiplication, result = num1 * num2 / 2^(64 * len) mod modulus.
+ * result may alias num1 or num2.
+ * @param result output of len limbs, below modulus
+ * @param num1 len limbs below modulus
+ * @param num2 len limbs below modulus
+ * @param modulus an odd modulus
+ * @param len length of modulus
+ * @param inverse the constant from _montgomeryInverse
+ * @param scratch 2 * len + _multiplyScratchSize(len) limbs of scratch space
+ * @param constantTime true to use the schoolbook product, whose timing ignores the values
+ */
+void big_integer::_montgomeryMultiply(limb_t *result, const limb_t *num1, const limb_t *num2,
+                                      const limb_t *modulus, size_t len, limb_t inverse,
+                                      limb_t *scratch, bool constantTime)
+{
+    if (constantTime)
+    {
+        _multiplySchoolbook(scratch, num1, len, num2, len);
+    }
+    else
+    {
+        _multiplyInScratch(scratch, num1, num2, len, scratch + 2 * len);
+    }
+    _montgomeryReduce(result, scratch, modulus, len, inverse);
+}
+
+/**
+ * @param len length of both operands
+ * @return the limbs of scratch space _multiplyInScratch needs for them, enough for any
+ * karatsuba threshold
+ */
+size_t big_integer::_multiplyScratchSize(size_t len)
+{
+    // every level keeps two sums and their product, and the longest sub-product is the one
+    // of the sums. the lowest threshold splits the most levels
+    size_t size = 0;
+    while (len >= MIN_SPLIT_THRESHOLD)
+    {
+        size_t half = (len + 1) / 2;
+        size += 4 * half + 4;
+        len = half + 1;
+    }
+    return size;
+}
+
+/**
+ * karatsuba multiplication of two numbers of the same length that keeps its temporaries
+ * in caller scratch instead of allocating, for the fixed size products of modular
+ * reduction. squares when num1 and num2 are the same limbs. the operands need not be
+ * normalized.
+ * @param result output of 2 * len limbs, must not alias the operands or scratch
+ * @param num1 a number
+ * @param num2 a number
+ * @param len length of both numbers
+ * @param scratch _multiplyScratchSize(len) limbs of scratch space
+ */
+void big_integer::_multiplyInScratch(limb_t *result, const limb_t *num1, const limb_t *num2,
+                                     size_t len, limb_t *scratch)
+{
+    bool squaring = num1 == num2;
+    if (squaring ? len * 100 < _multiplicationThresholds.karatsuba * SQUARE_KARATSUBA_PERCENT
+                 : len < _multiplicationThresholds.karatsuba)
+    {
+        if (squaring)
+        {
+            _squareSchoolbook(result, num1, len);
+        }
+        else
+        {
+            _multiplySchoolbook(result, num1, len, num2, len);
+        }
+        return;
+    }
+    // num1 = high1 * B^half + low1, num2 = high2 * B^half + low2. low1 * low2 goes to the
+    // low limbs and high1 * high2 to the high limbs, the sub-products share the rest of scratch
+    size_t half = (len + 1) / 2, highLen = len - half;
+    limb_t *sum1 = scratch, *sum2 = sum1 + half + 1, *middle = sum2 + half + 1;
+    limb_t *rest = middle + 2 * half + 2;
+    _multiplyInScratch(result, num1, num2, half, rest);
+    _multiplyInScratch(result + 2 * half, num1 + half, num2 + half, highLen, rest);
+
+    // middle = (low1 + high1) * (low2 + high2) - low1 * low2 - high1 * high2, which is
+    // low1 * high2 + high1 * low2 and fits len + 1 limbs
+    sum1[half] = _add(sum1, num1, half, num1 + half, highLen);
+    if (squaring)
+    {
+        sum2 = sum1;
+    }
+    else
+    {
+        sum2[half] = _add(sum2, num2, half, num2 + half, highLen);
+    }
+    _multiplyInScratch(middle, sum1, sum2, half + 1, rest);
+    _substract(middle, middle, 2 * half + 2, result, 2 * half);
+    _substract(middle, middle, 2 * half + 2, result + 2 * half, 2 * highLen);
+    _add(result + half, result + half, 2 * len - half, middle,
+         _trimmedLength(middle, 2 * half + 2));
+}
+
+/**
+ * greatest common divisor. numbers of up to two limbs take the binary algorithm, longer
+ * ones lehmer's algorithm on the leading words, and long ones the subquadratic half gcd.
+ * @param num1 a number
+ * @param num2 a number
+ * @return gcd(|num1|, |num2|), 0 only if both are 0
+ */
+big_integer big_integer::gcd(const big_integer &num1, const big_integer &num2)
+{
+    bool swapped = _compareMagnitude(num1._limbs.data(), num1._limbs.size(), num2._limbs.data(),
+                                     num2._limbs.size()) < 0;
+    big_integer larger(swapped ? num2 : num1), smaller(swapped ? num1 : num2);
+    larger._isPositive = true;
+    smaller._isPositive = true;
+    _gcdReduce(larger, smaller, nullptr, 0);
+    return larger;
+}
+
+/**
+ * least common multiple
+ * @param num1 a number
+ * @param num2 a number
+ * @return the smallest non negative common multiple, 0 if either number is 0
+ */
+big_integer big_integer::lcm(const big_integer &num1, const big_integer &num2)
+{
+    big_integer res;
+    if (num1._limbs.empty() || num2._limbs.empty())
+    {
+        return res;
+    }
+    // divide before multiplying, the gcd is usually much shorter than the numbers
+    limb_vector remainder;
+    _divideMagnitude(num1._limbs, gcd(num1, num2)._limbs, res._limbs, remainder);
+    big_integer magnitude(num2);
+    magnitude._isPositive = true;
+    return res * magnitude;
+}
+
+/**
+ * extended gcd, find bezout coefficients x and y with num1 * x + num2 * y = gcd.
+ * the outputs may be the inputs themselves but must be two different objects.
+ * @param num1 a number
+ * @param num2 a number
+ * @param x output, the coefficient of num1
+ * @param y output, the coefficient of num2
+ * @return gcd(|num1|, |num2|)
+ */
+big_integer big_integer::gcd_extended(const big_integer &num1, const big_integer &num2,
+                                      big_integer &x, big_integer &y)
+{
+    bool swapped = _compareMagnitude(num1._limbs.data(), num1._limbs.size(), num2._limbs.data(),
+                                     num2._limbs.size()) < 0;
+    big_integer first(swapped ? num2 : num1), second(swapped ? num1 : num2);
+    bool firstPositive = first._isPositive, secondPositive = second._isPositive;
+    first._isPositive = true;
+    second._isPositive = true;
+
+    // only the coefficient of the larger number is tracked, the other one follows from it
+    big_integer larger(first), smaller(second), coefficient1(1), coefficient2;
+    big_integer *tracked[2] = {&coefficient1, &coefficient2};
+    _gcdReduce(larger, smaller, tracked, 1);
+    if (second._limbs.empty())
+    {
+        coefficient2._initDataMembers();
+    }
+    else
+    {
+        coefficient2 = (larger - first * coefficient1) / second;
+    }
+
+    if (!firstPositive)
+    {
+        coefficient1._isPositive = !coefficient1._isPositive || coefficient1._limbs.empty();
+    }
+    if (!secondPositive)
+    {
+        coefficient2._isPositive = !coefficient2._isPositive || coefficient2._limbs.empty();
+    }
+    coefficient1._resetHash();
+    coefficient2._resetHash();
+    x = std::move(swapped ? coefficient2 : coefficient1);
+    y = std::move(swapped ? coefficient1 : coefficient2);
+    return larger;
+}
+
+/**
+ * modular inverse
+ * @param num the number, a negative number is taken as its non negative residue
+ * @param modulus the modulus, its sign is ignored
+ * @return the x in [0, |modulus|) with num * x = 1 mod |modulus|, 0 if num and modulus are
+ * not coprime or |modulus| is at most 1
+ */
+big_integer big_integer::mod_inverse(const big_integer &num, const big_integer &modulus)
+{
+    big_integer res;
+    const limb_vector &mod = modulus._limbs;
+    if (mod.empty() || (mod.size() == 1 && mod[0] == 1))
+    {
+        return res;
+    }
+    big_integer residue, magnitude(modulus), coefficient, unused;
+    magnitude._isPositive = true;
+    _reduceNonNegative(num, mod, residue._limbs);
+    big_integer divisor = gcd_extended(residue, magnitude, coefficient, unused);
+    if (divisor._limbs.size() == 1 && divisor._limbs[0] == 1)
+    {
+        _reduceNonNegative(coefficient, mod, res._limbs);
+    }
+    return res;
+}
+
+/**
+ * reduce a number to its non negative residue
+ * @param num a number of any sign
+ * @param modulus a non zero magnitude
+ * @param result output, num mod modulus in [0, modulus)
+ */
+void big_integer::_reduceNonNegative(const big_integer &num, const limb_vector &modulus,
+                                     limb_vector &result)
+{
+    limb_vector quotient;
+    _divideMagnitude(num._limbs, modulus, quotient, result);
+    if (!num._isPositive && !result.empty())
+    {
+        limb_vector negated(modulus.size());
+        _substract(negated.data(), modulus.data(), modulus.size(), result.data(), result.size());
+        _normalize(negated);
+        result = std::move(negated);
+    }
+}
+
+/**
+ * run euclid's algorithm on two magnitudes until num2 is 0.
+ * every step (num1, num2) -> (m00 * num1 + m01 * num2, m10 * num1 + m11 * num2) is also
+ * applied to the tracked pairs (u, v), so tracking (1, 0) gives the bezout coefficient
+ * of the original num1.
+ * @param num1 a magnitude, not below num2, ends as the gcd
+ * @param num2 a magnitude, ends as 0
+ * @param tracked 2 * count pointers, pair i is (tracked[2i], tracked[2i + 1])
+ * @param count number of tracked pairs
+ */
+void big_integer::_gcdReduce(big_integer &num1, big_integer &num2, big_integer **tracked,
+                             size_t count)
+{
+    limb_vector scratch[2];
+    while (!num2._limbs.empty())
+    {
+        if (count == 0 && num1._limbs.size() <= 2)
+        {
+            fromNative(num1._limbs, binaryGcd(toNative(num1._limbs), toNative(num2._limbs)));
+            num2._limbs.clear();
+        }
+        else if (num2._limbs.size() >= HALF_GCD_THRESHOLD)
+        {
+            // the half gcd stops just before the quotients depend on the low half, one
+            // division step gets past that point
+            _halfGcd(num1, num2, tracked, count);
+            if (!num2._limbs.empty())
+            {
+                _gcdDivisionStep(num1, num2, tracked, count);
+            }
+        }
+        else
+        {
+            _lehmerStep(num1, num2, scratch, tracked, count);
+        }
+    }
+    num1._resetHash();
+    num2._resetHash();
+}
+
+/**
+ * half gcd, reduce two magnitudes of n limbs by euclid steps until num2 has about n / 2
+ * limbs, the steps are applied to the tracked pairs like in _gcdReduce.
+ * the numbers are first reduced through a recursive call on their leading half, one
+ * division step follows, and a second recursive call on the leading part of the result
+ * takes them to n / 2 limbs.
+ * @param num1 a magnitude, not below num2
+ * @param num2 a magnitude
+ * @param tracked 2 * count pointers to the tracked pairs
+ * @param count number of tracked pairs
+ */
+void big_integer::_halfGcd(big_integer &num1, big_integer &num2, big_integer **tracked,
+                           size_t count)
+{
+    // the steps on the leading limbs are those of the whole numbers while the remainders
+    // stay above the square root of the leading part, a limb of margin keeps them there
+    size_t len = num1._limbs.size(), target = len / 2 + 2;
+    if (num2._limbs.size() <= target)
+    {
+        return;
+    }
+    if (len >= HALF_GCD_THRESHOLD)
+    {
+        // reducing the leading half to a quarter takes the numbers to 3/4 of their length
+        _halfGcdLeading(num1, num2, len / 2, tracked, count);
+        if (num2._limbs.size() > target)
+        {
+            _gcdDivisionStep(num1, num2, tracked, count);
+        }
+        // a leading part of 2 * (current - target) limbs drops by current - target limbs
+        size_t current = num1._limbs.size();
+        if (num2._limbs.size() > target && current < len)
+        {
+            _halfGcdLeading(num1, num2, len - current, tracked, count);
+        }
+    }
+    limb_vector scratch[2];
+    while (num2._limbs.size() > target)
+    {
+        _lehmerStep(num1, num2, scratch, tracked, count);
+    }
+}
+
+/**
+ * reduce the leading parts num1 / 2^(64 * shift) and num2 / 2^(64 * shift) by _halfGcd and
+ * apply the steps taken to the whole numbers and to the tracked pairs
+ * @param num1 a magnitude, not below num2
+ * @param num2 a magnitude
+ * @param shift number of low limbs left out
+ * @param tracked 2 * count pointers to the tracked pairs
+ * @param count number of tracked pairs
+ */
+void big_integer::_halfGcdLeading(big_integer &num1, big_integer &num2, size_t shift,
+                                  big_integer **tracked, size_t count)
+{
+    big_integer leading1 = _shiftedRight(num1, shift * LIMB_BITS);
+    big_integer leading2 = _shiftedRight(num2, shift * LIMB_BITS);
+
+    // the columns of the matrix are tracked, so it ends as the product of all the steps
+    big_integer matrix[4] = {big_integer(1), big_integer(), big_integer(), big_integer(1)};
+    big_integer *columns[4] = {&matrix[0], &matrix[2], &matrix[1], &matrix[3]};
+    _halfGcd(leading1, leading2, columns, 2);
+    if (matrix[1]._limbs.empty() && matrix[2]._limbs.empty() && matrix[0]._isPositive &&
+        matrix[3]._isPositive)
+    {
+        return;
+    }
+
+    big_integer res1 = matrix[0] * num1 + matrix[1] * num2;
+    big_integer res2 = matrix[2] * num1 + matrix[3] * num2;
+    num1 = std::move(res1);
+    num2 = std::move(res2);
+    _trackTransform(tracked, count, matrix);
+
+    // the low limbs may push a step one too far, any sign flip or swap keeps the gcd
+    bool negate1 = !num1._isPositive, negate2 = !num2._isPositive;
+    num1._isPositive = true;
+    num2._isPositive = true;
+    bool swap = _compareMagnitude(num1._limbs.data(), num1._limbs.size(), num2._limbs.data(),
+                                  num2._limbs.size()) < 0;
+    if (negate1 || negate2 || swap)
+    {
+        big_integer fix[4] = {_fromWord(negate1 ? -1 : 1), big_integer(), big_integer(),
+                              _fromWord(negate2 ? -1 : 1)};
+        if (swap)
+        {
+            std::swap(num1, num2);
+            std::swap(fix[0], fix[2]);
+            std::swap(fix[1], fix[3]);
+        }
+        _trackTransform(tracked, count, fix);
+    }
+    num1._resetHash();
+    num2._resetHash();
+}
+
+/**
+ * one step of lehmer's algorithm: the quotients of the leading 62 bits are collected into a
+ * matrix of single words while they are certainly those of the whole numbers, then the
+ * matrix is applied at once. falls back to a division step when no quotient is certain.
+ * @param num1 a magnitude, not below num2
+ * @param num2 a non zero magnitude
+ * @param scratch two vectors that are swapped with the limbs of num1 and num2
+ * @param tracked 2 * count pointers to the tracked pairs
+ * @param count number of tracked pairs
+ */
+void big_integer::_lehmerStep(big_integer &num1, big_integer &num2, limb_vector *scratch,
+                              big_integer **tracked, size_t count)
+{
+    const limb_vector &limbs1 = num1._limbs, &limbs2 = num2._limbs;
+    size_t bits = _bitLength(limbs1.data(), limbs1.size());
+    size_t start = bits > LEHMER_BITS ? bits - LEHMER_BITS : 0;
+    std::int64_t x = std::int64_t(_extractBits(limbs1.data(), limbs1.size(), start, LEHMER_BITS));
+    std::int64_t y = std::int64_t(_extractBits(limbs2.data(), limbs2.size(), start, LEHMER_BITS));
+
+    // knuth's algorithm L: x + m00 and x + m01 bound the leading bits of the current num1,
+    // a quotient is taken only when both bounds agree on it
+    std::int64_t m00 = 1, m01 = 0, m10 = 0, m11 = 1;
+    while (y + m10 > 0 && y + m11 > 0)
+    {
+        std::int64_t quotient = (x + m00) / (y + m10);
+        if (quotient != (x + m01) / (y + m11))
+        {
+            break;
+        }
+        std::int64_t next = m00 - quotient * m10;
+        m00 = m10;
+        m10 = next;
+        next = m01 - quotient * m11;
+        m01 = m11;
+        m11 = next;
+        next = x - quotient * y;
+        x = y;
+        y = next;
+    }
+    if (m01 == 0)
+    {
+        _gcdDivisionStep(num1, num2, tracked, count);
+        return;
+    }
+
+    _combineLimbs(scratch[0], limbs1, m00, limbs2, m01);
+    _combineLimbs(scratch[1], limbs1, m10, limbs2, m11);
+    std::swap(num1._limbs, scratch[0]);
+    std::swap(num2._limbs, scratch[1]);
+    if (count != 0)
+    {
+        big_integer matrix[4] = {_fromWord(m00), _fromWord(m01), _fromWord(m10), _fromWord(m11)};
+        _trackTransform(tracked, count, matrix);
+    }
+}
+
+/**
+ * one step of euclid's algorithm, (num1, num2) -> (num2, num1 mod num2)
+ * @param num1 a magnitude, not below num2
+ * @param num2 a non zero magnitude
+ * @param tracked 2 * count pointers to the tracked pairs
+ * @param count number of tracked pairs
+ */
+void big_integer::_gcdDivisionStep(big_integer &num1, big_integer &num2, big_integer **tracked,
+                                   size_t count)
+{
+    big_integer quotient;
+    limb_vector remainder;
+    _divideMagnitude(num1._limbs, num2._limbs, quotient._limbs, remainder);
+    std::swap(num1._limbs, num2._limbs);
+    num2._limbs = std::move(remainder);
+    for (size_t i = 0; i < count; i++)
+    {
+        // (u, v) -> (v, u - quotient * v)
+        big_integer &first = *tracked[2 * i], &second = *tracked[2 * i + 1];
+        first -= quotient * second;
+        std::swap(first, second);
+    }
+}
+
+/**
+ * apply a 2x2 matrix to the tracked pairs, (u, v) -> (m00 * u + m01 * v, m10 * u + m11 * v)
+ * @param tracked 2 * count pointers to the tracked pairs
+ * @param count number of tracked pairs
+ * @param matrix the entries m00, m01, m10, m11
+ */
+void big_integer::_trackTransform(big_integer **tracked, size_t count, const big_integer *matrix)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        big_integer &first = *tracked[2 * i], &second = *tracked[2 * i + 1];
+        big_integer res1 = matrix[0] * first + matrix[1] * second;
+        second = matrix[2] * first + matrix[3] * second;
+        first = std::move(res1);
+    }
+}
+
+/**
+ * result = coefficient1 * num1 + coefficient2 * num2 for a combination known not to be
+ * negative
+ * @param result output, normalized
+ * @param num1 a magnitude
+ * @param coefficient1 its coefficient
+ * @param num2 a magnitude
+ * @param coefficient2 its coefficient
+ */
+void big_integer::_combineLimbs(limb_vector &result, const limb_vector &num1,
+                                std::int64_t coefficient1, const limb_vector &num2,
+                                std::int64_t coefficient2)
+{
+    // start from the term with the non negative coefficient
+    const limb_vector *first = &num1, *second = &num2;
+    if (coefficient1 < 0)
+    {
+        std::swap(first, second);
+        std::swap(coefficient1, coefficient2);
+    }
+    size_t len1 = first->size(), len2 = second->size();
+    size_t len = std::max(len1, len2) + 1;
+    result.assign(len, 0);
+    result[len1] = _multiplyAddSmall(result.data(), first->data(), len1, limb_t(coefficient1), 0);
+
+    bool negative = coefficient2 < 0;
+    limb_t multiplier = negative ? limb_t(0) - limb_t(coefficient2) : limb_t(coefficient2);
+    limb_t carry = negative ? _substractMultiplyRow(result.data(), second->data(), len2, multiplier)
+                            : _addMultiplyRow(result.data(), second->data(), len2, multiplier);
+    for (size_t i = len2; carry != 0 && i < len; i++)
+    {
+        carry = negative ? __builtin_sub_overflow(result[i], carry, &result[i])
+                         : __builtin_add_overflow(result[i], carry, &result[i]);
+    }
+    _normalize(result);
+}
+
+/**
+ * @param value a word
+ * @return value as a big_integer
+ */
+big_integer big_integer::_fromWord(std::int64_t value)
+{
+    big_integer res;
+    if (value != 0)
+    {
+        res._limbs.push_back(value < 0 ? limb_t(0) - limb_t(value) : limb_t(value));
+        res._isPositive = value > 0;
+    }
+    return res;
+}
+
+/**
+ * square a number, about half the partial products of num * num. num * num picks
+ * this automatically.
+ * @param num a number
+ * @return num * num
+ */
+big_integer big_integer::square(const big_integer &num)
+{
+    big_integer res;
+    size_t len = num._limbs.size();
+    if (len == 1)
+    {
+        fromNative(res._limbs, dlimb_t(num._limbs[0]) * num._limbs[0]);
+    }
+    else if (len > 1)
+    {
+        res._limbs.resize(2 * len);
+        _square(res._limbs.data(), num._limbs.data(), len);
+        _normalize(res._limbs);
+    }
+    return res;
+}
+
+/**
+ * integer square root
+ * @param num a number
+ * @return floor(sqrt(num)), 0 for a negative number
+ */
+big_integer big_integer::isqrt(const big_integer &num)
+{
+    if (!num._isPositive)
+    {
+        return big_integer();
+    }
+    return _rootMagnitude(num, 2);
+}
+
+/**
+ * integer k-th root by newton iteration with precision doubling: the root of the leading
+ * half of the digits, scaled back, is one newton step away from the root of num, so the
+ * whole computation costs a few multiplications and divisions of the full length.
+ * @param num a number
+ * @param k the degree of the root
+ * @return the k-th root of num rounded towards 0, 0 if k is 0 or k is even and num negative
+ */
+big_integer big_integer::iroot(const big_integer &num, unsigned int k)
+{
+    if (k == 0 || (!num._isPositive && k % 2 == 0))
+    {
+        return big_integer();
+    }
+    big_integer magnitude(num);
+    magnitude._isPositive = true;
+    big_integer res = _rootMagnitude(magnitude, k);
+    res._isPositive = num._isPositive || res._limbs.empty();
+    return res;
+}
+
+/**
+ * @param num a number
+ * @return true if num is the square of an integer
+ */
+bool big_integer::is_perfect_square(const big_integer &num)
+{
+    if (!num._isPositive)
+    {
+        return false;
+    }
+    if (num._limbs.empty())
+    {
+        return true;
+    }
+    // most non squares are ruled out by their residues before any root is taken
+    if (((SQUARES_MOD_64 >> (num._limbs[0] & 63)) & 1) == 0)
+    {
+        return false;
+    }
+    limb_t residue = 0;
+    for (size_t i = num._limbs.size(); i > 0; i--)
+    {
+        residue = limb_t(((dlimb_t(residue) << LIMB_BITS) | num._limbs[i - 1]) %
+                         SQUARE_FILTER_MODULUS);
+    }
+    if (!isSquareResidue(residue % 63, 63) || !isSquareResidue(residue % 65, 65) ||
+        !isSquareResidue(residue % 11, 11))
+    {
+        return false;
+    }
+    big_integer root = _rootMagnitude(num, 2);
+    return root * root == num;
+}
+
+/**
+ * @param num a number
+ * @return true if num = r^k for some integers r and k >= 2
+ */
+bool big_integer::is_perfect_power(const big_integer &num)
+{
+    size_t bits = _bitLength(num._limbs.data(), num._limbs.size());
+    if (bits <= 1)
+    {
+        return true;
+    }
+    big_integer magnitude(num);
+    magnitude._isPositive = true;
+
+    // a power r^k is also r'^p for every prime p dividing k, so prime exponents are enough.
+    // r >= 2 bounds p below the bit length, a negative number needs an odd p, and a number
+    // with t trailing zero bits needs p to divide t, which leaves its odd part a p-th power
+    size_t zeros = _trailingZeroBits(num._limbs.data(), num._limbs.size());
+    big_integer odd = _shiftedRight(magnitude, zeros);
+    size_t oddBits = bits - zeros;
+    double oddLog = leadingLog2(odd._limbs);
+    for (unsigned int p = num._isPositive ? 2 : 3; p < bits; p++)
+    {
+        if (!isSmallPrime(p) || (zeros != 0 && zeros % p != 0))
+        {
+            continue;
+        }
+        if (p == 2)
+        {
+            if (is_perfect_square(magnitude))
+            {
+                return true;
+            }
+            continue;
+        }
+        // r^p has between p * (b - 1) + 1 and p * b bits for a b bit root r
+        size_t rootBits = (oddBits + p - 1) / p;
+        big_integer root;
+        if (rootBits <= ROOT_SEED_BITS)
+        {
+            // a word sized root is the only odd word whose p-th power ends like the odd part,
+            // it must also have the right bit length and leading bits
+            limb_t candidate = oddRootModWord(odd._limbs[0], p);
+            if (size_t(LIMB_BITS - __builtin_clzll(candidate)) != rootBits ||
+                std::fabs(p * std::log2(double(candidate)) - oddLog) >
+                ROOT_LOG_TOLERANCE * (1 + oddLog) || !passesPowerResidues(odd._limbs, p))
+            {
+                continue;
+            }
+            root = big_integer(candidate);
+        }
+        else
+        {
+            if (!passesPowerResidues(odd._limbs, p))
+            {
+                continue;
+            }
+            root = _rootMagnitude(odd, p);
+        }
+        if (_power(root, p) == odd)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * multiply numbers in a balanced tree: every round multiplies neighbours pairwise
+ * @param factors the numbers, used as scratch
+ * @return their product, 1 if there are none
+ */
+big_integer big_integer::_product(std::vector<big_integer> &factors)
+{
+    if (factors.empty())
+    {
+        return big_integer(1);
+    }
+    while (factors.size() > 1)
+    {
+        size_t count = factors.size(), next = 0;
+        for (size_t i = 0; i + 1 < count; i += 2)
+        {
+            factors[next++] = factors[i] * factors[i + 1];
+        }
+        if (count % 2 != 0)
+        {
+            factors[next++] = std::move(factors[count - 1]);
+        }
+        factors.resize(next);
+    }
+    return std::move(factors[0]);
+}
+
+/**
+ * factorial by a product tree of the odd factors, the powers of 2 are one shift at the end
+ * @param n a number
+ * @return n!
+ */
+big_integer big_integer::factorial(std::uint64_t n)
+{
+    // the odd part of n! is the product over i >= 0 of the odd numbers up to n >> i, and those
+    // are the odd numbers up to n >> (i + 1) times the ones in (n >> (i + 1), n >> i]
+    big_integer oddPart(1), oddUpTo(1);
+    for (int i = LIMB_BITS - 1; i >= 0; i--)
+    {
+        std::uint64_t high = n >> i;
+        if (high < 3)
+        {
+            continue;
+        }
+        std::uint64_t low = high >> 1;
+        packed_factors factors;
+        for (std::uint64_t odd = (low + 1) | 1; odd <= high; odd += 2)
+        {
+            factors.push(odd);
+        }
+        oddUpTo *= factors.product();
+        oddPart *= oddUpTo;
+    }
+    // n! has n - popcount(n) factors of 2
+    return oddPart << size_t(n - __builtin_popcountll(n));
+}
+
+/**
+ * binomial coefficient, from its factorization into prime powers (legendre's formula)
+ * multiplied in a product tree. a small k against a huge n divides the product of the k
+ * top factors by k! instead, to save sieving up to n.
+ * @param n the size of the set
+ * @param k the size of the subsets
+ * @return n choose k, 0 if k > n
+ */
+big_integer big_integer::binomial(std::uint64_t n, std::uint64_t k)
+{
+    if (k > n)
+    {
+        return big_integer();
+    }
+    k = std::min(k, n - k);
+    packed_factors factors;
+    if (n / BINOMIAL_DIVISION_RATIO > k)
+    {
+        for (std::uint64_t factor = n - k + 1; factor <= n && factor != 0; factor++)
+        {
+            factors.push(factor);
+        }
+        return factors.product() / factorial(k);
+    }
+    forEachPrime(n, [&](std::uint64_t prime)
+    {
+        // the exponent of prime is the number of borrows when substracting k from n in base
+        // prime, which keeps the prime power below n
+        std::uint64_t power = 1;
+        for (std::uint64_t top = n, bottom = k, rest = n - k; top != 0;)
+        {
+            top /= prime;
+            bottom /= prime;
+            rest /= prime;
+            for (std::uint64_t borrows = top - bottom - rest; borrows != 0; borrows--)
+            {
+                power *= prime;
+            }
+        }
+        if (power != 1)
+        {
+            factors.push(power);
+        }
+    });
+    return factors.product();
+}
+
+/**
+ * product of the primes up to n, sieved and multiplied in a product tree
+ * @param n a number
+ * @return n#, 1 if n < 2
+ */
+big_integer big_integer::primorial(std::uint64_t n)
+{
+    packed_factors factors;
+    forEachPrime(n, [&](std::uint64_t prime)
+    {
+        factors.push(prime);
+    });
+    return factors.product();
+}
+
+/**
+ * the k-th root of a magnitude, computed from the root of its leading bits
+ * @param num a magnitude
+ * @param k the degree of the root, not 0
+ * @return floor(num^(1/k))
+ */
+big_integer big_integer::_rootMagnitude(const big_integer &num, unsigned int k)
+{
+    big_integer res;
+    size_t bits = _bitLength(num._limbs.data(), num._limbs.size());
+    if (bits <= size_t(LIMB_BITS))
+    {
+        fromNative(res._limbs, nativeRoot(num._limbs.empty() ? 0 : num._limbs[0], k));
+        return res;
+    }
+    if (k >= bits)
+    {
+        return big_integer(1);
+    }
+
+    // the root r has at most rootBits bits. the root of num / 2^(k * shift) times 2^shift
+    // is r within a relative error of about 2^(shift - rootBits), and a newton step squares
+    // that error, so guard bits growing with log k leave it below 1
+    size_t rootBits = (bits + k - 1) / k;
+    size_t guard = size_t(2 + 32 - __builtin_clz(k));
+    if (rootBits <= ROOT_SEED_BITS || rootBits / 2 <= guard)
+    {
+        // a short root: seeded just above it from the leading bits, newton from above falls
+        // to it in a couple of steps
+        double seed = std::exp2(leadingLog2(num._limbs) / k) * (1 + ROOT_SEED_MARGIN) + 1;
+        res = seed < WORD_RANGE ? big_integer(limb_t(seed))
+                                : _shiftedLeft(big_integer(1), rootBits);
+        while (true)
+        {
+            big_integer next = _rootNewtonStep(num, res, k);
+            if (next >= res)
+            {
+                return res;
+            }
+            res = std::move(next);
+        }
+    }
+    size_t shift = rootBits / 2 - guard;
+    big_integer approximation = _shiftedLeft(_rootMagnitude(_shiftedRight(num, k * shift), k),
+                                             shift);
+    res = _rootNewtonStep(num, approximation, k);
+    while (_power(res, k) > num)
+    {
+        res -= 1;
+    }
+    return res;
+}
+
+/**
+ * one newton step towards the k-th root, from any x > 0 the result is at least the root
+ * @param num a magnitude
+ * @param x the current approximation, not 0
+ * @param k the degree of the root
+ * @return floor(((k - 1) * x + num / x^(k - 1)) / k)
+ */
+big_integer big_integer::_rootNewtonStep(const big_integer &num, const big_integer &x,
+                                         unsigned int k)
+{
+    big_integer degree = _fromWord(k);
+    return (_fromWord(k - 1) * x + num / _power(x, k - 1)) / degree;
+}
+
+/**
+ * @param base the base
+ * @param exponent the exponent
+ * @return base^exponent, by repeated squaring
+ */
+big_integer big_integer::_power(const big_integer &base, unsigned int exponent)
+{
+    big_integer res(1), square(base);
+    for (; exponent != 0; exponent >>= 1)
+    {
+        if ((exponent & 1) != 0)
+        {
+            res *= square;
+        }
+        if (exponent > 1)
+        {
+            square = square * square;
+        }
+    }
+    return res;
+}
+
+/**
+ * put this big_integer in stream
+ * @param output the stream
+ * @param num the big integer to put in the stream
+ * @return an updated stream
+ */
+ostream &operator<<(ostream &output, const big_integer &num)
+{
+    string numStr = "";
+    if (!num._isPositive)
+    {
+        numStr += "-";
+    }
+    numStr += num._toDecimalString();
+    output << numStr;
+    return output;
+}
+
+/**
+ * get the decimal digits of the magnitude (without sign)
+ * @return the magnitude in base 10
+ */
+string big_integer::_toDecimalString() const
+{
+    string numStr;
+    if (_limbs.size() < DECIMAL_CONVERSION_THRESHOLD)
+    {
+        _appendDecimalNaive(_limbs, 0, numStr);
+        return numStr;
+    }
+    // find the first level whose digit count covers the number, log10(2) < 30103 / 100000
+    size_t bits = _bitLength(_limbs.data(), _limbs.size());
+    size_t maxDigits = bits * 30103 / 100000 + 1, level = 0;
+    while (DECIMAL_CHUNK_DIGITS << (level + 1) < maxDigits)
+    {
+        level++;
+    }
+    numStr.reserve(maxDigits);
+    _appendDecimal(*this, level, false, numStr);
+    return numStr;
+}
+
+/**
+ * append the decimal digits of a positive number, splitting it recursively by
+ * the cached powers of 10. num must be below 10^(19 * 2^(level + 1)).
+ * @param num the number
+ * @param level the level of the power to split by
+ * @param padded true to pad with zeros to exactly 19 * 2^(level + 1) digits
+ * @param output the string to append to
+ */
+void big_integer::_appendDecimal(const big_integer &num, size_t level, bool padded,
+                                 string &output)
+{
+    if (num._limbs.size() < DECIMAL_CONVERSION_THRESHOLD)
+    {
+        _appendDecimalNaive(num._limbs, padded ? DECIMAL_CHUNK_DIGITS << (level + 1) : 0, output);
+        return;
+    }
+    // num = high * 10^(19 * 2^level) + low, both halves are below the next level's bound
+    big_integer high, low;
+    divmod(num, _decimalPower(level), high, low);
+    if (padded || !high._limbs.empty())
+    {
+        _appendDecimal(high, level - 1, padded, output);
+        padded = true;
+    }
+    _appendDecimal(low, level - 1, padded, output);
+}
+
+/**
+ * append the decimal digits of a magnitude one limb sized chunk at a time
+ * @param limbs a magnitude
+ * @param width pad with zeros to this many digits
+ * @param output the string to append to
+ */
+void big_integer::_appendDecimalNaive(const limb_vector &limbs, size_t width, string &output)
+{
+    // peel DECIMAL_CHUNK digits at a time from the least significant end
+    limb_vector temp = limbs;
+    std::vector<limb_t> chunks;
+    while (!temp.empty())
+    {
+        chunks.push_back(_divideBySmall(temp.data(), temp.data(), temp.size(), DECIMAL_CHUNK));
+        _normalize(temp);
+    }
+    if (chunks.empty())
+    {
+        chunks.push_back(0);
+    }
+    string numStr = std::to_string(chunks.back());
+    for (unsigned long i = chunks.size() - 1; i > 0; i--)
+    {
+        string chunk = std::to_string(chunks[i - 1]);
+        numStr.append(DECIMAL_CHUNK_DIGITS - chunk.length(), '0');
+        numStr += chunk;
+    }
+    if (numStr.length() < width)
+    {
+        output.append(width - numStr.length(), '0');
+    }
+    output += numStr;
+}
+
+/**
+ * read a positive number out of decimal digits, splitting them recursively by
+ * the cached powers of 10
+ * @param digits the digits, all between '0' and '9'
+ * @param len the number of digits
+ * @return the number
+ */
+big_integer big_integer::_parseDecimal(const char *digits, size_t len)
+{
+    big_integer res;
+    if (len >= DECIMAL_PARSE_THRESHOLD * DECIMAL_CHUNK_DIGITS)
+    {
+        // the low part takes the largest 19 * 2^level digits that leave a high part
+        size_t level = 0;
+        while (DECIMAL_CHUNK_DIGITS << (level + 1) < len)
+        {
+            level++;
+        }
+        size_t lowLen = DECIMAL_CHUNK_DIGITS << level;
+        res = _parseDecimal(digits, len - lowLen) * _decimalPower(level) +
+              _parseDecimal(digits + len - lowLen, lowLen);
+        return res;
+    }
+    // read the digits in chunks of DECIMAL_CHUNK_DIGITS, the first chunk takes the leftover
+    size_t chunkLen = len % DECIMAL_CHUNK_DIGITS;
+    if (chunkLen == 0)
+    {
+        chunkLen = DECIMAL_CHUNK_DIGITS;
+    }
+    size_t i = 0;
+    while (i < len)
+    {
+        limb_t chunk = 0, multiplier = 1;
+        for (; chunkLen > 0; chunkLen--, i++)
+        {
+            chunk = chunk * 10 + limb_t(digits[i] - '0');
+            multiplier *= 10;
+        }
+        limb_t carry = _multiplyAddSmall(res._limbs.data(), res._limbs.data(), res._limbs.size(),
+                                         multiplier, chunk);
+        if (carry != 0)
+        {
+            res._limbs.push_back(carry);
+        }
+        chunkLen = DECIMAL_CHUNK_DIGITS;
+    }
+    _normalize(res._limbs);
+    return res;
+}
+
+/**
+ * get a cached power of 10, computed once by repeated squaring and then reused
+ * @param level the level of the power
+ * @return 10^(19 * 2^level)
+ */
+const big_integer &big_integer::_decimalPower(size_t level)
+{
+    std::lock_guard<std::mutex> lock(decimalPowersMutex);
+    // the cache outlives any arena the caller may have made current
+    limb_allocator_scope heap(nullptr);
+    if (decimalPowers.empty())
+    {
+        big_integer chunk;
+        chunk._limbs.push_back(DECIMAL_CHUNK);
+        decimalPowers.push_back(chunk);
+    }
+    while (decimalPowers.size() <= level)
+    {
+        const big_integer &last = decimalPowers.back();
+        decimalPowers.push_back(last * last);
+    }
+    return decimalPowers[level];
+}
+
+/**
+ * if num is 0 make it positive
+ * @param num big_integer
+ * @return the number
+ */
+big_integer &big_integer::_makeZeroPositive(big_integer &num) const
+{
+    if (num._limbs.empty())
+    {
+        num._isPositive = true;
+    }
+    return num;
+}
+
+
+/**
+ * assigns other * this to this
+ * @param other
+ * @return this after doing this * other
+ */
+big_integer &big_integer::operator*=(const big_integer &other)
+{
+    *this = *this * other;
+    return *this;
+}
+
+/**
+ * this function calculate this += other
+ * @param other big_integer
+ * @return return this after doing this += other
+ */
+big_integer &big_integer::operator+=(const big_integer &other)
+{
+    _addSigned(*this, *this, other, false);
+    return *this;
+}
+
+/**
+ * this method calculate this -= other
+ * @param other big_integer
+ * @return return this after doing this -= other
+ */
+big_integer &big_integer::operator-=(const big_integer &other)
+{
+    _addSigned(*this, *this, other, true);
+    return *this;
+}
+
+
+/**
+ * compare to other big_integer for equality check.
+ * @param other big_integer to compare.
+ * @return true if other is equal to this object, false otherwise.
+ */
+bool big_integer::operator==(const big_integer &other) const
+{
+    return this->_limbs == other._limbs && this->_isPositive == other._isPositive;
+}
+
+/**
+ * compare to other big_integer for inequality
+ * @param other big_integer to compare.
+ * @return true if other is not equal to this object, false otherwise.
+ */
+bool big_integer::operator!=(const big_integer &other) const
+{
+    return !(*this == other);
+}
+
+/**
+ * three way comparison, scans the limbs from the most significant end
+ * @param other the number to compare to
+ * @return -1 if this < other, 0 if they are equal, 1 if this > other
+ */
+int big_integer::compare(const big_integer &other) const
+{
+    if (_isPositive != other._isPositive)
+    {
+        return _isPositive ? 1 : -1;
+    }
+    int cmp = _compareMagnitude(_limbs.data(), _limbs.size(), other._limbs.data(),
+                                other._limbs.size());
+    // for negative numbers the larger magnitude is the smaller number
+    return _isPositive ? cmp : -cmp;
+}
+
+/**
+ * hash the sign and the limbs a word at a time. the value is computed on the first call and
+ * kept in the object until it changes, later calls cost O(1).
+ * @return the hash of this number
+ */
+size_t big_integer::hash() const
+{
+    size_t cached = _hash.load(std::memory_order_relaxed);
+    if (cached != 0)
+    {
+        return cached;
+    }
+    // fold two limbs per step through a 64x64->128 multiplication
+    size_t len = _limbs.size();
+    std::uint64_t h = (std::uint64_t(len) << 1 | (_isPositive ? 0 : 1)) ^ HASH_MULTIPLIER2;
+    size_t i = 0;
+    for (; i + 1 < len; i += 2)
+    {
+        h ^= hashMix(_limbs[i] ^ HASH_MULTIPLIER1, _limbs[i + 1] ^ h);
+    }
+    if (i < len)
+    {
+        h ^= hashMix(_limbs[i] ^ HASH_MULTIPLIER1, h ^ HASH_MULTIPLIER2);
+    }
+    h = hashMix(h ^ HASH_MULTIPLIER1, HASH_MULTIPLIER2);
+    // 0 marks a hash that was not computed yet
+    cached = h != 0 ? size_t(h) : 1;
+    _hash.store(cached, std::memory_order_relaxed);
+    return cached;
+}
+
 /**
- * get an integer and construct a big number
- * @param number a number
+ * @return the length in bytes of the sort key of this number
+ */
+size_t big_integer::sort_key_size() const
+{
+    return SORT_KEY_HEADER_SIZE + _limbs.size() * sizeof(limb_t);
+}
+
+/**
+ * write a binary key that orders like the number under memcmp: a sign byte, the limb count
+ * and the magnitude, all big endian, with the count and magnitude inverted for negatives.
+ * keys of different lengths already differ in their first 9 bytes, so comparing the common
+ * prefix with memcmp and then the lengths orders any two keys.
+ * @param buffer output, must have room for sort_key_size() bytes
+ * @return the number of bytes written
  */
-big_integer::big_integer(int number)
+size_t big_integer::sort_key(unsigned char *buffer) const
 {
-    if (number == 0)
+    // inverting every bit reverses the order, so a longer negative number sorts first
+    std::uint64_t flip = _isPositive ? 0 : ~std::uint64_t(0);
+    unsigned char *out = buffer;
+    *out++ = _isPositive ? SORT_KEY_NON_NEGATIVE : SORT_KEY_NEGATIVE;
+    out = _writeBigEndian(out, std::uint64_t(_limbs.size()) ^ flip);
+    for (size_t i = _limbs.size(); i > 0; i--)
     {
-        _initDataMembers();
+        out = _writeBigEndian(out, _limbs[i - 1] ^ flip);
+    }
+    return size_t(out - buffer);
+}
+
+/**
+ * @return the sort key of this number as a byte string, see sort_key(unsigned char *)
+ */
+string big_integer::sort_key() const
+{
+    string key(sort_key_size(), '\0');
+    sort_key(reinterpret_cast<unsigned char *>(&key[0]));
+    return key;
+}
+
+/**
+ * @return the length in bytes of the binary encoding of this number
+ */
+size_t big_integer::serialized_size() const
+{
+    size_t varintBytes = 1;
+    for (size_t count = _limbs.size() >> SERIAL_VARINT_BITS; count != 0;
+         count >>= SERIAL_VARINT_BITS)
+    {
+        varintBytes++;
+    }
+    return 2 + varintBytes + _limbs.size() * SERIAL_LIMB_BYTES;
+}
+
+/**
+ * write the compact binary encoding of this number: a version byte, the limb count as a
+ * varint (7 bits per byte, least significant first), a sign byte and the limbs, least
+ * significant first, 8 little endian bytes each. it is read back by deserialize, or in
+ * place by big_integer_view.
+ * @param buffer output, must have room for serialized_size() bytes
+ * @return the number of bytes written
+ */
+size_t big_integer::serialize(unsigned char *buffer) const
+{
+    unsigned char *out = buffer;
+    *out++ = SERIAL_VERSION;
+    size_t count = _limbs.size();
+    for (; (count >> SERIAL_VARINT_BITS) != 0; count >>= SERIAL_VARINT_BITS)
+    {
+        *out++ = static_cast<unsigned char>(count | SERIAL_VARINT_MORE);
+    }
+    *out++ = static_cast<unsigned char>(count);
+    *out++ = _isPositive ? SERIAL_NON_NEGATIVE : SERIAL_NEGATIVE;
+    writeLittleEndian(out, _limbs.data(), _limbs.size());
+    return size_t(out - buffer) + _limbs.size() * SERIAL_LIMB_BYTES;
+}
+
+/**
+ * @return the binary encoding of this number as a byte string, see
+ * serialize(unsigned char *)
+ */
+string big_integer::serialize() const
+{
+    string bytes(serialized_size(), '\0');
+    serialize(reinterpret_cast<unsigned char *>(&bytes[0]));
+    return bytes;
+}
+
+/**
+ * read a number written by serialize
+ * @param buffer the encoding
+ * @param size number of bytes available in buffer, it may hold more after the encoding
+ * @param num output, 0 if the encoding is invalid
+ * @return the number of bytes read, 0 if the encoding is truncated, has an unknown
+ * version or is not normalized
+ */
+size_t big_integer::deserialize(const unsigned char *buffer, size_t size, big_integer &num)
+{
+    size_t count = 0;
+    bool negative = false;
+    size_t header = _readSerialHeader(buffer, size, count, negative);
+    num._resetHash();
+    if (header == 0)
+    {
+        num._limbs.clear();
+        num._isPositive = true;
+        return 0;
+    }
+    num._limbs.resize(count);
+    _readLimbs(num._limbs.data(), buffer + header, count);
+    num._isPositive = !negative;
+    return header + count * SERIAL_LIMB_BYTES;
+}
+
+/**
+ * compare the two number by > operator
+ * @param other the number to compare to
+ * @return compare the two number, if this > other return true, false otherwise
+ */
+bool big_integer::operator>(const big_integer &other) const
+{
+    return compare(other) > 0;
+}
+
+/**
+ * compare the two number by < operator
+ * @param other the number to compare to
+ * @return compare the two number, if this < other return true, false otherwise
+ */
+bool big_integer::operator<(const big_integer &other) const
+{
+    return compare(other) < 0;
+}
+
+/**
+ * compare this to other using >=
+ * @param other big_integer
+ * @return true if this >= other, false otherwise.
+ */
+bool big_integer::operator>=(const big_integer &other) const
+{
+    return compare(other) >= 0;
+}
+
+/**
+ * comapre this to other using <=
+ * @param other big_integer
+ * @return true if this <= other, false otherwise.
+ */
+bool big_integer::operator<=(const big_integer &other) const
+{
+    return compare(other) <= 0;
+}
+
+/**
+ * write a 64 bit word most significant byte first
+ * @param out the output bytes
+ * @param word the word
+ * @return the position after the written bytes
+ */
+unsigned char *big_integer::_writeBigEndian(unsigned char *out, std::uint64_t word)
+{
+    for (int shift = 56; shift >= 0; shift -= 8)
+    {
+        *out++ = static_cast<unsigned char>(word >> shift);
+    }
+    return out;
+}
+
+/**
+ * check a binary encoding of serialize and read its header
+ * @param buffer the encoding
+ * @param size number of bytes available in buffer
+ * @param count output, the number of limbs
+ * @param negative output, the sign
+ * @return the length of the header, the limbs follow it. 0 if the encoding is invalid
+ */
+size_t big_integer::_readSerialHeader(const unsigned char *buffer, size_t size, size_t &count,
+                                      bool &negative)
+{
+    if (size == 0 || buffer[0] != SERIAL_VERSION)
+    {
+        return 0;
+    }
+    size_t pos = 1;
+    std::uint64_t length = 0;
+    for (int shift = 0;; shift += SERIAL_VARINT_BITS)
+    {
+        if (pos == size || pos > SERIAL_VARINT_MAX_BYTES)
+        {
+            return 0;
+        }
+        unsigned char byte = buffer[pos++];
+        std::uint64_t bits = byte & ~SERIAL_VARINT_MORE;
+        // only the shortest varint is valid: no zero last byte after the first and no bits
+        // past the 64th, so every count has a single encoding
+        if (shift != 0 && (byte == 0 || bits >> (64 - shift) != 0))
+        {
+            return 0;
+        }
+        length |= bits << shift;
+        if ((byte & SERIAL_VARINT_MORE) == 0)
+        {
+            break;
+        }
+    }
+    if (pos == size || (buffer[pos] != SERIAL_NON_NEGATIVE && buffer[pos] != SERIAL_NEGATIVE))
+    {
+        return 0;
+    }
+    negative = buffer[pos++] == SERIAL_NEGATIVE;
+    if (length > (size - pos) / SERIAL_LIMB_BYTES)
+    {
+        return 0;
+    }
+    count = size_t(length);
+    // only the normalized form is valid: no leading zero limb and no negative 0
+    limb_t top = 0;
+    if (count != 0)
+    {
+        _readLimbs(&top, buffer + pos + (count - 1) * SERIAL_LIMB_BYTES, 1);
+    }
+    if (count == 0 ? negative : top == 0)
+    {
+        return 0;
+    }
+    return pos;
+}
+
+/**
+ * read limbs stored as 8 little endian bytes each, at any alignment
+ * @param limbs output
+ * @param bytes the stored limbs
+ * @param count number of limbs
+ */
+void big_integer::_readLimbs(limb_t *limbs, const unsigned char *bytes, size_t count)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::memcpy(limbs, bytes, count * SERIAL_LIMB_BYTES);
+#else
+    for (size_t i = 0; i < count; i++)
+    {
+        limbs[i] = 0;
+        for (size_t j = 0; j < SERIAL_LIMB_BYTES; j++)
+        {
+            limbs[i] |= limb_t(*bytes++) << (8 * j);
+        }
+    }
+#endif
+}
+
+/**
+ * remove unwanted zero limbs from the end of a number
+ * @param limbs a magnitude
+ */
+void big_integer::_normalize(limb_vector &limbs)
+{
+    while (!limbs.empty() && limbs.back() == 0)
+    {
+        limbs.pop_back();
+    }
+}
+
+/**
+ * add num1 and num2 into result, num1 must be at least as long as num2.
+ * result must have room for len1 limbs and may alias num1 or num2.
+ * @param result the output limbs
+ * @param num1 the longer number
+ * @param len1 length of num1
+ * @param num2 the shorter number
+ * @param len2 length of num2
+ * @return the carry out of the most significant limb
+ */
+big_integer::limb_t big_integer::_add(limb_t *result, const limb_t *num1, size_t len1,
+                                      const limb_t *num2, size_t len2)
+{
+    limb_t carry = len2 < VECTOR_CARRY_THRESHOLD ? addCarryScalar(result, num1, num2, len2, 0)
+                                                 : addKernel()(result, num1, num2, len2, 0);
+    // the carry dies out quickly, after that the rest of num1 is only copied
+    size_t i = len2;
+    for (; carry != 0 && i < len1; i++)
+    {
+        carry = __builtin_add_overflow(num1[i], carry, &result[i]);
+    }
+    if (result != num1)
+    {
+        std::copy(num1 + i, num1 + len1, result + i);
+    }
+    return carry;
+}
+
+/**
+ * substract num2 from num1 into result, num1 must be at least as long as num2.
+ * result must have room for len1 limbs and may alias num1 or num2.
+ * @param result the output limbs
+ * @param num1 a number
+ * @param len1 length of num1
+ * @param num2 a number
+ * @param len2 length of num2
+ * @return the borrow out of the most significant limb (1 if num2 > num1)
+ */
+big_integer::limb_t big_integer::_substract(limb_t *result, const limb_t *num1, size_t len1,
+                                            const limb_t *num2, size_t len2)
+{
+    limb_t borrow = len2 < VECTOR_CARRY_THRESHOLD
+                    ? substractBorrowScalar(result, num1, num2, len2, 0)
+                    : substractKernel()(result, num1, num2, len2, 0);
+    size_t i = len2;
+    for (; borrow != 0 && i < len1; i++)
+    {
+        borrow = __builtin_sub_overflow(num1[i], borrow, &result[i]);
+    }
+    if (result != num1)
+    {
+        std::copy(num1 + i, num1 + len1, result + i);
+    }
+    return borrow;
+}
+
+/**
+ * compare two normalized magnitudes
+ * @param num1 a number
+ * @param len1 length of num1
+ * @param num2 a number
+ * @param len2 length of num2
+ * @return negative if num1 < num2, 0 if equal, positive if num1 > num2
+ */
+int big_integer::_compareMagnitude(const limb_t *num1, size_t len1, const limb_t *num2,
+                                   size_t len2)
+{
+    if (len1 != len2)
+    {
+        return len1 < len2 ? -1 : 1;
+    }
+    // scan from the most significant limb
+    for (size_t i = len1; i > 0; i--)
+    {
+        if (num1[i - 1] != num2[i - 1])
+        {
+            return num1[i - 1] < num2[i - 1] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * multiplication of magnitudes, result must have room for len1 + len2 limbs
+ * and must not alias the inputs. picks the algorithm by operand length.
+ * @param result the output limbs
+ * @param num1 a number
+ * @param len1 length of num1
+ * @param num2 a number
+ * @param len2 length of num2
+ */
+void big_integer::_multiply(limb_t *result, const limb_t *num1, size_t len1, const limb_t *num2,
+                            size_t len2)
+{
+    // the algorithms below work on normalized operands, the limbs above the product are zero
+    size_t fullLen = len1 + len2;
+    len1 = _trimmedLength(num1, len1);
+    len2 = _trimmedLength(num2, len2);
+    std::fill(result + len1 + len2, result + fullLen, limb_t(0));
+    if (num1 == num2 && len1 == len2)
+    {
+        _square(result, num1, len1);
         return;
     }
-    // init data
-    this->_data = "";
-    this->_isPositive = true;
-    if (number < 0)
+    if (len1 < len2)
     {
-        this->_isPositive = false;
+        std::swap(num1, num2);
+        std::swap(len1, len2);
+    }
+    // the tasks of a parallel product allocate on several threads at once, which an arena
+    // of the caller does not allow, so its temporaries come from the heap
+    limb_allocator_scope allocator(_isParallel(len2) ? nullptr : limb_allocator::current());
+    if (len2 < _multiplicationThresholds.karatsuba)
+    {
+        _multiplySchoolbook(result, num1, len1, num2, len2);
+    }
+    else if (len2 >= _multiplicationThresholds.ntt)
+    {
+        _multiplyNtt(result, num1, len1, num2, len2);
+    }
+    else if (len1 >= 2 * len2)
+    {
+        _multiplyBySlices(result, num1, len1, num2, len2, len2);
+    }
+    else if (len2 < _multiplicationThresholds.toom3)
+    {
+        _multiplyKaratsuba(result, num1, len1, num2, len2);
     }
-    // build number
-    while (number != 0)
+    else
     {
-        this->_data += std::to_string(abs(number % 10));
-        number /= 10;
+        _multiplyToom3(result, num1, len1, num2, len2);
     }
 }
 
 /**
- * construct a big integer out of a big integer
- * @param bigNum an integer
+ * @param len length of the shorter operand of a product
+ * @return true if the product is long enough to split across threads
  */
-big_integer::big_integer(const big_integer &other)
+bool big_integer::_isParallel(size_t len)
 {
-    this->_data = string(other._data);
-    this->_isPositive = other._isPositive;
+    return _multiplicationParallelism.threads > 1 && len >= _multiplicationParallelism.threshold;
 }
 
 /**
- * constructor
- * @param number a string representation of number
+ * schoolbook multiplication, same contract as _multiply
+ * @param result the output limbs
+ * @param num1 a number
+ * @param len1 length of num1
+ * @param num2 a number
+ * @param len2 length of num2
  */
-big_integer::big_integer(const string &number)
+void big_integer::_multiplySchoolbook(limb_t *result, const limb_t *num1, size_t len1,
+                                      const limb_t *num2, size_t len2)
 {
-    // if string len is 0 or string is "-" init with default values
-    if (number.length() == 0 || number == MINUS_STR)
+    std::fill(result, result + len1 + len2, limb_t(0));
+    for (size_t i = 0; i < len2; i++)
     {
-        _initDataMembers();
+        result[i + len1] = _addMultiplyRow(result + i, num1, len1, num2[i]);
+    }
+}
+
+/**
+ * multiply num1 slice by slice with num2 and accumulate the partial products,
+ * same contract as _multiply
+ * @param result the output limbs
+ * @param num1 a number
+ * @param len1 length of num1
+ * @param num2 a number
+ * @param len2 length of num2
+ * @param sliceLen the length of the slices of num1
+ */
+void big_integer::_multiplyBySlices(limb_t *result, const limb_t *num1, size_t len1,
+                                    const limb_t *num2, size_t len2, size_t sliceLen)
+{
+    std::fill(result, result + len1 + len2, limb_t(0));
+    limb_vector product(sliceLen + len2);
+    for (size_t offset = 0; offset < len1; offset += sliceLen)
+    {
+        size_t curLen = std::min(sliceLen, len1 - offset);
+        _multiply(product.data(), num1 + offset, curLen, num2, len2);
+        // the sum so far is below B^(offset + len2), so this never carries out
+        _add(result + offset, result + offset, len1 + len2 - offset, product.data(),
+             curLen + len2);
+    }
+}
+
+/**
+ * karatsuba multiplication, same contract as _multiply with len1 >= len2
+ * @param result the output limbs
+ * @param num1 a number
+ * @param len1 length of num1
+ * @param num2 a number
+ * @param len2 length of num2
+ */
+void big_integer::_multiplyKaratsuba(limb_t *result, const limb_t *num1, size_t len1,
+                                     const limb_t *num2, size_t len2)
+{
+    // num1 = high1 * B^half + low1, num2 = high2 * B^half + low2
+    size_t half = (len1 + 1) / 2;
+    if (len2 <= half)
+    {
+        // num2 has no high part, two half sized products are enough
+        _multiplyBySlices(result, num1, len1, num2, len2, half);
         return;
     }
+    size_t high1Len = len1 - half, high2Len = len2 - half;
+    // low1 * low2 goes to the low limbs, high1 * high2 to the high limbs and
+    // (low1 + high1) * (low2 + high2) to middle, three independent products
+    limb_vector scratch(4 * half + 4);
+    limb_t *sum1 = scratch.data(), *sum2 = sum1 + half + 1, *middle = sum2 + half + 1;
+    size_t sum1Len = 0, sum2Len = 0;
+    parallelFor(_isParallel(len2), 3, [&](size_t product)
+    {
+        if (product == 0)
+        {
+            _multiply(result, num1, half, num2, half);
+        }
+        else if (product == 1)
+        {
+            _multiply(result + 2 * half, num1 + half, high1Len, num2 + half, high2Len);
+        }
+        else
+        {
+            sum1[half] = _add(sum1, num1, half, num1 + half, high1Len);
+            sum2[half] = _add(sum2, num2, half, num2 + half, high2Len);
+            sum1Len = _trimmedLength(sum1, half + 1);
+            sum2Len = _trimmedLength(sum2, half + 1);
+            _multiply(middle, sum1, sum1Len, sum2, sum2Len);
+        }
+    });
 
-    // init data members
-    this->_data = "";
-    this->_isPositive = true;
+    // middle = (low1 + high1) * (low2 + high2) - low1 * low2 - high1 * high2
+    size_t middleLen = sum1Len + sum2Len;
+    _substract(middle, middle, middleLen, result, _trimmedLength(result, 2 * half));
+    _substract(middle, middle, middleLen, result + 2 * half,
+               _trimmedLength(result + 2 * half, high1Len + high2Len));
+    _add(result + half, result + half, len1 + len2 - half, middle,
+         _trimmedLength(middle, middleLen));
+}
 
-    // put the number in data
-    int end = 0;
-    this->_isPositive = true;
-    if (!number.empty() && number[0] == MINUS_SIGN)
+/**
+ * toom-3 multiplication, same contract as _multiply with len1 >= len2
+ * @param result the output limbs
+ * @param num1 a number
+ * @param len1 length of num1
+ * @param num2 a number
+ * @param len2 length of num2
+ */
+void big_integer::_multiplyToom3(limb_t *result, const limb_t *num1, size_t len1,
+                                 const limb_t *num2, size_t len2)
+{
+    // split both numbers to three parts of third limbs: num = x2 * X^2 + x1 * X + x0
+    size_t third = (len1 + 2) / 3;
+    big_integer points1[5], points2[5], values[5];
+    _toom3Evaluate(num1, len1, third, points1);
+    _toom3Evaluate(num2, len2, third, points2);
+    parallelFor(_isParallel(len2), 5, [&](size_t i)
     {
-        end = 1;
-        this->_isPositive = false;
+        values[i] = points1[i] * points2[i];
+    });
+    _toom3Interpolate(result, len1 + len2, third, values);
+}
+
+/**
+ * evaluate the toom-3 polynomial of a number at 0, 1, -1, -2 and infinity
+ * @param num a number
+ * @param len length of num
+ * @param third the length of the coefficients
+ * @param points output, the five values
+ */
+void big_integer::_toom3Evaluate(const limb_t *num, size_t len, size_t third, big_integer *points)
+{
+    big_integer x0 = _sliceLimbs(num, len, 0, third), x1 = _sliceLimbs(num, len, third, third),
+            x2 = _sliceLimbs(num, len, 2 * third, third);
+    big_integer x02 = x0 + x2;
+    points[1] = x02 + x1;
+    points[2] = x02 - x1;
+    points[3] = points[2] + x2;
+    points[3] = points[3] + points[3] - x0;
+    points[0] = std::move(x0);
+    points[4] = std::move(x2);
+}
+
+/**
+ * interpolate the toom-3 product polynomial from its values and add up its coefficients
+ * @param result output of fullLen limbs
+ * @param fullLen length of the product
+ * @param third the length of the coefficients
+ * @param values the product at 0, 1, -1, -2 and infinity, overwritten
+ */
+void big_integer::_toom3Interpolate(limb_t *result, size_t fullLen, size_t third,
+                                    big_integer *values)
+{
+    big_integer &r0 = values[0], &rPlus1 = values[1], &rMinus1 = values[2],
+            &rMinus2 = values[3], &rInf = values[4];
+
+    // interpolation (Bodrato's sequence), all divisions are exact
+    const big_integer two = big_integer(2), three = big_integer(3);
+    big_integer r3 = (rMinus2 - rPlus1) / three;
+    big_integer r1 = (rPlus1 - rMinus1) / two;
+    big_integer r2 = rMinus1 - r0;
+    r3 = (r2 - r3) / two + rInf + rInf;
+    r2 = r2 + r1 - rInf;
+    r1 = r1 - r3;
+
+    // the coefficients are the (non negative) coefficients of the product polynomial
+    const big_integer *coefficients[] = {&r0, &r1, &r2, &r3, &rInf};
+    std::fill(result, result + fullLen, limb_t(0));
+    for (size_t i = 0; i < 5; i++)
+    {
+        const limb_vector &limbs = coefficients[i]->_limbs;
+        _add(result + i * third, result + i * third, fullLen - i * third, limbs.data(),
+             limbs.size());
     }
-    for (long i = number.size() - 1; i >= end; i--)
+}
+
+/**
+ * multiplication with a number theoretic transform over three word sized primes,
+ * the coefficients are recombined with the chinese remainder theorem.
+ * a square (num1 and num2 the same limbs) needs a single forward transform per prime.
+ * same contract as _multiply
+ * @param result the output limbs
+ * @param num1 a number
+ * @param len1 length of num1
+ * @param num2 a number
+ * @param len2 length of num2
+ */
+void big_integer::_multiplyNtt(limb_t *result, const limb_t *num1, size_t len1,
+                               const limb_t *num2, size_t len2)
+{
+    size_t n = 1;
+    while (n < len1 + len2 - 1)
     {
-        if (number[i] < '0' || number[i] > '9')
+        n <<= 1;
+    }
+    // the cyclic convolution of the limbs modulo every prime, the primes are independent
+    bool squaring = num1 == num2 && len1 == len2, parallel = _isParallel(std::min(len1, len2));
+    std::vector<std::uint64_t> residues[NTT_PRIME_COUNT];
+    parallelFor(parallel, NTT_PRIME_COUNT, [&](size_t p)
+    {
+        const ntt_prime &prime = NTT_PRIMES[p];
+        std::vector<std::uint64_t> &values = residues[p];
+        values.assign(n, 0);
+        for (size_t i = 0; i < len1; i++)
+        {
+            values[i] = prime.toMontgomery(num1[i]);
+        }
+        nttTransform(values, prime, false, parallel);
+        if (squaring)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                values[i] = prime.multiply(values[i], values[i]);
+            }
+        }
+        else
+        {
+            std::vector<std::uint64_t> other(n, 0);
+            for (size_t i = 0; i < len2; i++)
+            {
+                other[i] = prime.toMontgomery(num2[i]);
+            }
+            nttTransform(other, prime, false, parallel);
+            for (size_t i = 0; i < n; i++)
+            {
+                values[i] = prime.multiply(values[i], other[i]);
+            }
+        }
+        nttTransform(values, prime, true, parallel);
+        for (size_t i = 0; i < n; i++)
         {
-            _initDataMembers();
-            return;
+            values[i] = prime.fromMontgomery(values[i]);
         }
-        _data += number[i];
-    }
-    _removeZeros(_data);
-    _makeZeroPositive(*this);
-}
+    });
 
+    // garner's constants: x = v1 + v2 * p1 + v3 * p1 * p2
+    const ntt_prime &prime1 = NTT_PRIMES[0], &prime2 = NTT_PRIMES[1], &prime3 = NTT_PRIMES[2];
+    // multiplying a plain value by a constant in montgomery form gives a plain value
+    std::uint64_t inverse12 = prime2.power(prime2.toMontgomery(prime1.modulus),
+                                           prime2.modulus - 2);
+    std::uint64_t prime1Mod3 = prime3.toMontgomery(prime1.modulus);
+    std::uint64_t inverse123 = prime3.power(
+            prime3.multiply(prime1Mod3, prime3.toMontgomery(prime2.modulus)), prime3.modulus - 2);
+    dlimb_t prime12 = dlimb_t(prime1.modulus) * prime2.modulus;
+    limb_t prime12Low = limb_t(prime12), prime12High = limb_t(prime12 >> LIMB_BITS);
 
-/**
- * init data members
- */
-void big_integer::_initDataMembers()
-{
-    this->_data = "0";
-    this->_isPositive = true;
+    // recombine every coefficient and propagate the carries into the result
+    dlimb_t carry = 0;
+    for (size_t i = 0; i < len1 + len2; i++)
+    {
+        limb_t x0 = 0, x1 = 0, x2 = 0;
+        if (i < n)
+        {
+            std::uint64_t v1 = residues[0][i];
+            std::uint64_t v1Mod2 = v1 >= prime2.modulus ? v1 - prime2.modulus : v1;
+            std::uint64_t v2 = prime2.multiply(prime2.substract(residues[1][i], v1Mod2),
+                                               inverse12);
+            std::uint64_t v1Mod3 = v1 >= prime3.modulus ? v1 - prime3.modulus : v1;
+            std::uint64_t partial3 = prime3.add(v1Mod3, prime3.multiply(v2, prime1Mod3));
+            std::uint64_t v3 = prime3.multiply(prime3.substract(residues[2][i], partial3),
+                                               inverse123);
+            dlimb_t low = dlimb_t(v2) * prime1.modulus + v1;
+            dlimb_t part0 = dlimb_t(v3) * prime12Low + limb_t(low);
+            dlimb_t part1 = dlimb_t(v3) * prime12High + limb_t(low >> LIMB_BITS) +
+                            limb_t(part0 >> LIMB_BITS);
+            x0 = limb_t(part0);
+            x1 = limb_t(part1);
+            x2 = limb_t(part1 >> LIMB_BITS);
+        }
+        dlimb_t sum = dlimb_t(x0) + limb_t(carry);
+        result[i] = limb_t(sum);
+        carry = (dlimb_t(x2) << LIMB_BITS) + x1 + limb_t(carry >> LIMB_BITS) +
+                limb_t(sum >> LIMB_BITS);
+    }
 }
 
 /**
- * adds this to other and return the result
- * @param other big_integer
- * @return this + other
+ * squaring of a magnitude, result must have room for 2 * len limbs and must not alias
+ * num. picks the algorithm by length with the thresholds of _multiply, except that the
+ * schoolbook square stays faster than karatsuba a bit longer.
+ * @param result the output limbs
+ * @param num a number
+ * @param len length of num
  */
-big_integer big_integer::operator+(const big_integer &other) const
+void big_integer::_square(limb_t *result, const limb_t *num, size_t len)
 {
-    big_integer res;
-    res._isPositive = true;
-    // if this and other are both positive or negative
-    if (other._isPositive == _isPositive)
+    size_t fullLen = 2 * len;
+    len = _trimmedLength(num, len);
+    std::fill(result + 2 * len, result + fullLen, limb_t(0));
+    // like _multiply, a parallel square keeps its temporaries on the heap
+    limb_allocator_scope allocator(_isParallel(len) ? nullptr : limb_allocator::current());
+    if (len * 100 < _multiplicationThresholds.karatsuba * SQUARE_KARATSUBA_PERCENT)
     {
-        // if their sign is negative so is the sign of res
-        if (!other._isPositive)
-        {
-            res._isPositive = false;
-        }
-        res._data = _add(other._data, _data);
+        _squareSchoolbook(result, num, len);
     }
-        // if this is greater or equal to other in abs value
-    else if (_absValue(*this) >= _absValue(other))
+    else if (len >= _multiplicationThresholds.ntt)
     {
-        // change to negative
-        if (!_isPositive && *this != other)
-        {
-            res._isPositive = false;
-        }
-        res._data = _substract(_data, other._data);
+        _multiplyNtt(result, num, len, num, len);
+    }
+    else if (len < _multiplicationThresholds.toom3)
+    {
+        _squareKaratsuba(result, num, len);
     }
-        // other is greater than this
     else
     {
-        // if other is negative the sign is -
-        if (!other._isPositive)
-        {
-            res._isPositive = false;
-        }
-        res._data = _substract(other._data, _data);
+        _squareToom3(result, num, len);
     }
-    _makeZeroPositive(res);
-    return res;
 }
 
 /**
- * return this - other
- * @param other big_integer
- * @return this - other
+ * schoolbook squaring: every product num[i] * num[j] with i < j once, doubled, plus the
+ * squares of the limbs. same contract as _square
+ * @param result the output limbs
+ * @param num a number
+ * @param len length of num
  */
-big_integer big_integer::operator-(const big_integer &other) const
+void big_integer::_squareSchoolbook(limb_t *result, const limb_t *num, size_t len)
 {
-    big_integer negativeOther = big_integer(other);
-    negativeOther._isPositive = !other._isPositive;
-    return *this + negativeOther;
+    if (len == 0)
+    {
+        return;
+    }
+    // the products above the diagonal, row i covers num[i] * num[i + 1 .. len)
+    std::fill(result, result + 2 * len, limb_t(0));
+    for (size_t i = 0; i + 1 < len; i++)
+    {
+        result[i + len] = _addMultiplyRow(result + 2 * i + 1, num + i + 1, len - i - 1, num[i]);
+    }
+    // they are below B^(2 * len) / 2, so doubling never carries out
+    _shiftLeftBits(result, result, 2 * len, 1);
+    limb_t carry = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        dlimb_t diagonal = dlimb_t(num[i]) * num[i];
+        dlimb_t low = dlimb_t(result[2 * i]) + limb_t(diagonal) + carry;
+        dlimb_t high = dlimb_t(result[2 * i + 1]) + limb_t(diagonal >> LIMB_BITS) +
+                       limb_t(low >> LIMB_BITS);
+        result[2 * i] = limb_t(low);
+        result[2 * i + 1] = limb_t(high);
+        carry = limb_t(high >> LIMB_BITS);
+    }
 }
 
 /**
- * multiply this to other and return the result
- * @param other big_integer
- * @return this * other
+ * karatsuba squaring, three half sized squares. same contract as _square
+ * @param result the output limbs
+ * @param num a number
+ * @param len length of num
  */
-big_integer big_integer::operator*(const big_integer &other) const
+void big_integer::_squareKaratsuba(limb_t *result, const limb_t *num, size_t len)
 {
-    big_integer tempNum, res = big_integer(), smaller, larger;
-    _setLargerAndSmaller(*this, other, larger, smaller);
-    res._isPositive = true;
-    for (unsigned long i = 0; i < smaller._data.length(); i++)
+    // num = high * B^half + low, low^2 goes to the low limbs, high^2 to the high limbs
+    size_t half = (len + 1) / 2, highLen = len - half;
+    limb_vector scratch(3 * half + 3);
+    limb_t *sum = scratch.data(), *middle = sum + half + 1;
+    size_t sumLen = 0;
+    parallelFor(_isParallel(len), 3, [&](size_t product)
     {
-        big_integer digit = big_integer(_getDigit(smaller._data, i));
-        tempNum = big_integer(larger);
-        // long _multiplication
-        for (unsigned long j = 0; j < i; j++)
+        if (product == 0)
         {
-            tempNum._data = "0" + tempNum._data;
+            _square(result, num, half);
         }
-        tempNum = _multiplication(digit, tempNum);
-        res = res + tempNum;
-    }
-    // make the sign right
-    res._isPositive = false;
-    if (_isPositive == other._isPositive || res._data == "0")
-    {
-        res._isPositive = true;
-    }
-    return res;
+        else if (product == 1)
+        {
+            _square(result + 2 * half, num + half, highLen);
+        }
+        else
+        {
+            sum[half] = _add(sum, num, half, num + half, highLen);
+            sumLen = _trimmedLength(sum, half + 1);
+            _square(middle, sum, sumLen);
+        }
+    });
+
+    // middle = (low + high)^2 - low^2 - high^2
+    size_t middleLen = 2 * sumLen;
+    _substract(middle, middle, middleLen, result, _trimmedLength(result, 2 * half));
+    _substract(middle, middle, middleLen, result + 2 * half,
+               _trimmedLength(result + 2 * half, 2 * highLen));
+    _add(result + half, result + half, 2 * len - half, middle,
+         _trimmedLength(middle, middleLen));
 }
 
 /**
- * divide: this/ other
- * @param other divisor
- * @return this/ other
+ * toom-3 squaring, five third sized squares. same contract as _square
+ * @param result the output limbs
+ * @param num a number
+ * @param len length of num
  */
-big_integer big_integer::operator/(const big_integer &other) const
+void big_integer::_squareToom3(limb_t *result, const limb_t *num, size_t len)
 {
-    string numStr = _getReversedString(_data), resStr = "";
-    big_integer otherCpy = big_integer(other);
-    big_integer currSum = big_integer(), zero = big_integer(), ten = big_integer("10"),
-            div = big_integer();
-    otherCpy._isPositive = true;
-    for (unsigned long i = 0; i < numStr.length(); i++)
-    {
-        string temp = "";
-        temp += numStr[i];
-        currSum = currSum * ten;
-        currSum = currSum + big_integer(temp);
-        div = division(currSum, otherCpy);
-        string digit = _getReversedString(div._data);
-        resStr += digit;
-        currSum = currSum - (div * otherCpy);
-    }
-    //_removeZeros(resStr);
-    big_integer result = big_integer(resStr);
-    _removeZeros(result._data);
-    result._isPositive = _isPositive == other._isPositive;
-    result = _makeZeroPositive(result);
-    return result;
+    size_t third = (len + 2) / 3;
+    big_integer points[5], values[5];
+    _toom3Evaluate(num, len, third, points);
+    parallelFor(_isParallel(len), 5, [&](size_t i)
+    {
+        values[i] = square(points[i]);
+    });
+    _toom3Interpolate(result, 2 * len, third, values);
 }
 
 /**
- * divide: this%other
- * @param other divisor
- * @return this% other
+ * shift a positive big_integer left
+ * @param num the number
+ * @param bits number of bits to shift
+ * @return num * 2^bits
  */
-big_integer big_integer::operator%(const big_integer &other) const
+big_integer big_integer::_shiftedLeft(const big_integer &num, size_t bits)
 {
-    string numStr = _getReversedString(_data), resStr = "";
-    big_integer otherCpy = big_integer(other);
-    big_integer currSum = big_integer(), zero = big_integer(), ten = big_integer("10"),
-            div = big_integer();
-    otherCpy._isPositive = true;
-    for (unsigned long i = 0; i < numStr.length(); i++)
-    {
-        string temp = "";
-        temp += numStr[i];
-        currSum = currSum * ten;
-        currSum = currSum + big_integer(temp);
-        div = division(currSum, otherCpy);
-        string digit = _getReversedString(div._data);
-        resStr += digit;
-        currSum = currSum - (div * otherCpy);
-    }
-    currSum._isPositive = _isPositive == other._isPositive;
-    currSum = _makeZeroPositive(currSum);
-    if (other == 0)
+    big_integer res;
+    if (num._limbs.empty())
     {
-        currSum = big_integer();
+        return res;
     }
-    return currSum;
+    size_t limbShift = bits / LIMB_BITS, len = num._limbs.size();
+    res._limbs.assign(limbShift + len + 1, 0);
+    res._limbs[limbShift + len] = _shiftLeftBits(res._limbs.data() + limbShift, num._limbs.data(),
+                                                 len, int(bits % LIMB_BITS));
+    _normalize(res._limbs);
+    return res;
 }
 
 /**
- * this function calculate (this /= other)
- * @param other big_integer
- * @return return this after doing (this /= other)
+ * shift a positive big_integer right
+ * @param num the number
+ * @param bits number of bits to shift
+ * @return num / 2^bits
  */
-big_integer &big_integer::operator/=(const big_integer &other)
+big_integer big_integer::_shiftedRight(const big_integer &num, size_t bits)
 {
-    big_integer temp = big_integer(*this);
-    temp = temp / other;
-    this->_data = temp._data;
-    this->_isPositive = temp._isPositive;
-    return *this;
+    size_t limbShift = bits / LIMB_BITS, len = num._limbs.size();
+    big_integer res;
+    if (limbShift >= len)
+    {
+        return res;
+    }
+    res._limbs.resize(len - limbShift);
+    _shiftRightBits(res._limbs.data(), num._limbs.data() + limbShift, len - limbShift,
+                    int(bits % LIMB_BITS));
+    _normalize(res._limbs);
+    return res;
 }
 
 /**
- * put this big_integer in stream
- * @param output the stream
- * @param num the big integer to put in the stream
- * @return an updated stream
+ * get the number of significant bits of a magnitude
+ * @param num a number
+ * @param len length of num
+ * @return the position of the highest set bit plus one, 0 for zero
  */
-ostream &operator<<(ostream &output, const big_integer &num)
+size_t big_integer::_bitLength(const limb_t *num, size_t len)
 {
-    string numStr = "";
-    if (!num._isPositive)
+    len = _trimmedLength(num, len);
+    if (len == 0)
     {
-        numStr += "-";
+        return 0;
     }
-    numStr += num._getReversedString(num._data);
-    output << numStr;
-    return output;
+    return len * LIMB_BITS - size_t(__builtin_clzll(num[len - 1]));
 }
 
 /**
- * if num is 0 make it positive
- * @param num big_integer
- * @return the number
+ * get the number of trailing zero bits of a magnitude
+ * @param num a non zero number
+ * @param len length of num
+ * @return the position of the lowest set bit
  */
-big_integer &big_integer::_makeZeroPositive(big_integer &num) const
+size_t big_integer::_trailingZeroBits(const limb_t *num, size_t len)
 {
-    if (num._data == "0")
+    size_t i = 0;
+    while (i + 1 < len && num[i] == 0)
     {
-        num._isPositive = true;
+        i++;
     }
-    return num;
+    return i * LIMB_BITS + size_t(__builtin_ctzll(num[i]));
 }
 
-
 /**
- * assigns other * this to this
- * @param other
- * @return this after doing this * other
+ * get the length of a magnitude without its leading zero limbs
+ * @param num a number
+ * @param len length of num
+ * @return the normalized length
  */
-big_integer &big_integer::operator*=(const big_integer &other)
+size_t big_integer::_trimmedLength(const limb_t *num, size_t len)
 {
-    big_integer temp = big_integer(*this);
-    temp = temp * other;
-    this->_data = temp._data;
-    this->_isPositive = temp._isPositive;
-    return *this;
+    while (len > 0 && num[len - 1] == 0)
+    {
+        len--;
+    }
+    return len;
 }
 
 /**
- * this function calculate this += other
- * @param other big_integer
- * @return return this after doing this += other
+ * build a positive big_integer out of a part of a magnitude
+ * @param num a number
+ * @param len length of num
+ * @param start index of the first limb of the part
+ * @param count number of limbs in the part, clamped to the end of num
+ * @return the part as a big_integer
  */
-big_integer &big_integer::operator+=(const big_integer &other)
+big_integer big_integer::_sliceLimbs(const limb_t *num, size_t len, size_t start, size_t count)
 {
-    big_integer temp = big_integer(*this);
-    temp = temp + other;
-    this->_data = temp._data;
-    this->_isPositive = temp._isPositive;
-    return *this;
+    big_integer part;
+    if (start < len)
+    {
+        size_t end = std::min(len, start + count);
+        part._limbs.assign(num + start, num + end);
+        _normalize(part._limbs);
+    }
+    return part;
 }
 
 /**
- * this method calculate this -= other
- * @param other big_integer
- * @return return this after doing this -= other
+ * add num * multiplier to result, in place
+ * @param result the accumulator, len limbs are updated
+ * @param num the number
+ * @param len length of num
+ * @param multiplier the limb to multiply by
+ * @return the limb carried out of result[len - 1]
  */
-big_integer &big_integer::operator-=(const big_integer &other)
+big_integer::limb_t big_integer::_addMultiplyRow(limb_t *result, const limb_t *num, size_t len,
+                                                 limb_t multiplier)
 {
-    big_integer temp = big_integer(*this);
-    temp = temp - other;
-    this->_data = temp._data;
-    this->_isPositive = temp._isPositive;
-    return *this;
+    limb_t carry = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        dlimb_t cur = dlimb_t(num[i]) * multiplier + result[i] + carry;
+        result[i] = limb_t(cur);
+        carry = limb_t(cur >> LIMB_BITS);
+    }
+    return carry;
 }
 
-
 /**
- * compare to other big_integer for equality check.
- * @param other big_integer to compare.
- * @return true if other is equal to this object, false otherwise.
+ * substract num * multiplier from result, in place
+ * @param result the accumulator, len limbs are updated
+ * @param num the number
+ * @param len length of num
+ * @param multiplier the limb to multiply by
+ * @return the limb borrowed from result[len]
  */
-bool big_integer::operator==(const big_integer &other) const
+big_integer::limb_t big_integer::_substractMultiplyRow(limb_t *result, const limb_t *num,
+                                                       size_t len, limb_t multiplier)
 {
-    return this->_data == other._data && this->_isPositive == other._isPositive;
+    limb_t borrow = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        dlimb_t product = dlimb_t(num[i]) * multiplier + borrow;
+        limb_t low = limb_t(product);
+        borrow = limb_t(product >> LIMB_BITS) + (result[i] < low ? 1 : 0);
+        result[i] -= low;
+    }
+    return borrow;
 }
 
 /**
- * compare to other big_integer for inequality
- * @param other big_integer to compare.
- * @return true if other is not equal to this object, false otherwise.
+ * multiply num by a single limb and add a single limb
+ * @param result output of len limbs, may alias num
+ * @param num the number
+ * @param len length of num
+ * @param multiplier the limb to multiply by
+ * @param addend the limb to add
+ * @return the limb carried out of the most significant limb
  */
-bool big_integer::operator!=(const big_integer &other) const
+big_integer::limb_t big_integer::_multiplyAddSmall(limb_t *result, const limb_t *num, size_t len,
+                                                   limb_t multiplier, limb_t addend)
 {
-    return !(*this == other);
+    limb_t carry = addend;
+    for (size_t i = 0; i < len; i++)
+    {
+        dlimb_t cur = dlimb_t(num[i]) * multiplier + carry;
+        result[i] = limb_t(cur);
+        carry = limb_t(cur >> LIMB_BITS);
+    }
+    return carry;
 }
 
 /**
- * compare the two number by > operator
- * @param other the number to compare to
- * @return compare the two number, if this > other return true, false otherwise
+ * divide num by a single limb, multiplying by a precomputed reciprocal of the divisor
+ * instead of dividing every limb
+ * @param result output of len limbs, may alias num, or nullptr for the remainder only
+ * @param num the number
+ * @param len length of num
+ * @param divisor a non zero limb
+ * @return the remainder
  */
-bool big_integer::operator>(const big_integer &other) const
+big_integer::limb_t big_integer::_divideBySmall(limb_t *result, const limb_t *num, size_t len,
+                                                limb_t divisor)
 {
-    if (_isPositive && !other._isPositive)
-    {
-        return true;
-    }
-    if (!_isPositive && other._isPositive)
+    if (len == 0)
     {
-        return false;
+        return 0;
     }
-    if (!_isPositive)
+    // divide num * 2^shift by the normalized divisor, the quotient is the same and the
+    // remainder is shifted back at the end
+    int shift = __builtin_clzll(divisor);
+    limb_t normalized = divisor << shift, reciprocal = reciprocalOf(normalized);
+    limb_t remainder = shift != 0 ? num[len - 1] >> (LIMB_BITS - shift) : 0;
+    for (size_t i = len; i > 0; i--)
     {
-        if (_data.length() < other._data.length())
+        limb_t low = num[i - 1] << shift;
+        if (shift != 0 && i > 1)
         {
-            return true;
+            low |= num[i - 2] >> (LIMB_BITS - shift);
         }
-        else if (_data.length() > other._data.length())
+        limb_t quotient = divideTwoByOne(remainder, low, normalized, reciprocal, remainder);
+        if (result != nullptr)
         {
-            return false;
+            result[i - 1] = quotient;
         }
-        // we need to look at the reversed strings, so we could compare them
-        string thisStr = _getReversedString(_data);
-        string otherStr = _getReversedString(other._data);
-        bool flag = (thisStr) < (otherStr);
-        return flag;
-    }
-    if (_data.length() < other._data.length())
-    {
-        return false;
-    }
-    else if (_data.length() > other._data.length())
-    {
-        return true;
     }
-    // we need to look at the reversed strings, so we could compare them
-    string thisStr = _getReversedString(_data);
-    string otherStr = _getReversedString(other._data);
-    bool flag = (thisStr) > (otherStr);
-    return flag;
+    return remainder >> shift;
 }
 
 /**
- * compare the two number by < operator
- * @param other the number to compare to
- * @return compare the two number, if this < other return true, false otherwise
+ * divide two magnitudes, the divisor must not be zero.
+ * the outputs must not be the same vectors as the inputs.
+ * @param num the dividend
+ * @param divisor the divisor
+ * @param quotient output, num / divisor
+ * @param remainder output, num % divisor
  */
-bool big_integer::operator<(const big_integer &other) const
+void big_integer::_divideMagnitude(const limb_vector &num, const limb_vector &divisor,
+                                   limb_vector &quotient, limb_vector &remainder)
 {
-    if (_isPositive && !other._isPositive)
-    {
-        return false;
-    }
-    if (!_isPositive && other._isPositive)
-    {
-        return true;
-    }
-    if (!_isPositive)
-    {
-        if (_data.length() < other._data.length())
-        {
-            return false;
-        }
-        else if (_data.length() > other._data.length())
-        {
-            return true;
-        }
-        // we need to look at the reversed strings, so we could compare them
-        string thisStr = _getReversedString(_data);
-        string otherStr = _getReversedString(other._data);
-        bool flag = (thisStr) > (otherStr);//
-        return flag;
-    }
-    if (_data.length() < other._data.length())
+    if (divisor.size() >= BURNIKEL_ZIEGLER_THRESHOLD &&
+        num.size() >= divisor.size() + BURNIKEL_ZIEGLER_OFFSET)
     {
-        return true;
+        _divideBurnikelZiegler(num, divisor, quotient, remainder);
     }
-    else if (_data.length() > other._data.length())
+    else
     {
-        return false;
+        _divideBasecase(num, divisor, quotient, remainder);
     }
-    // we need to look at the reversed strings, so we could compare them
-    string thisStr = _getReversedString(_data);
-    string otherStr = _getReversedString(other._data);
-    bool flag = (thisStr) < (otherStr);
-    return flag;
 }
 
-
 /**
- * get the string in reverse
- * @param str string to reverse
- * @return reversed string
+ * divide two magnitudes without recursion (short division or knuth's algorithm D),
+ * same contract as _divideMagnitude
+ * @param num the dividend
+ * @param divisor the divisor
+ * @param quotient output, num / divisor
+ * @param remainder output, num % divisor
  */
-string big_integer::_getReversedString(const string &str) const
+void big_integer::_divideBasecase(const limb_vector &num, const limb_vector &divisor,
+                                  limb_vector &quotient, limb_vector &remainder)
 {
-    //todo free the memory
-    string newStr = string(str);
-    unsigned long len = newStr.length();
-    // reverse the strings
-    for (unsigned long i = 0; i < len / 2; i++)
+    if (_compareMagnitude(num.data(), num.size(), divisor.data(), divisor.size()) < 0)
+    {
+        quotient.clear();
+        remainder = num;
+        return;
+    }
+    if (divisor.size() == 1)
     {
-        char temp = newStr[i];
-        newStr[i] = newStr[len - i - 1];
-        newStr[len - i - 1] = temp;
+        quotient.resize(num.size());
+        limb_t rem = _divideBySmall(quotient.data(), num.data(), num.size(), divisor[0]);
+        _normalize(quotient);
+        remainder.assign(rem != 0 ? 1 : 0, rem);
+        return;
     }
-    return newStr;
+    quotient.assign(num.size() - divisor.size() + 1, 0);
+    remainder.assign(divisor.size(), 0);
+    _divideKnuth(quotient.data(), remainder.data(), num.data(), num.size(), divisor.data(),
+                 divisor.size());
+    _normalize(quotient);
+    _normalize(remainder);
 }
 
 /**
- * compare this to other using >=
- * @param other big_integer
- * @return true if this >= other, false otherwise.
+ * recursive division (burnikel-ziegler) for large operands, cuts the dividend into
+ * blocks of the (padded) divisor length and divides them with _divideTwoByOne.
+ * same contract as _divideMagnitude
+ * @param num the dividend
+ * @param divisor the divisor
+ * @param quotient output, num / divisor
+ * @param remainder output, num % divisor
  */
-bool big_integer::operator>=(const big_integer &other) const
+void big_integer::_divideBurnikelZiegler(const limb_vector &num, const limb_vector &divisor,
+                                         limb_vector &quotient, limb_vector &remainder)
 {
-    return !((*this) < other);
+    // pad the divisor to n = j * m limbs, m a power of 2 so that n halves down to the
+    // knuth threshold, and shift it so its top bit is set
+    size_t divLen = divisor.size(), m = 1;
+    while (m <= divLen / BURNIKEL_ZIEGLER_THRESHOLD)
+    {
+        m <<= 1;
+    }
+    size_t n = (divLen + m - 1) / m * m;
+    size_t sigma = n * LIMB_BITS - _bitLength(divisor.data(), divLen);
+    big_integer shiftedDivisor, shiftedNum;
+    shiftedDivisor._limbs = divisor;
+    shiftedNum._limbs = num;
+    shiftedDivisor = _shiftedLeft(shiftedDivisor, sigma);
+    shiftedNum = _shiftedLeft(shiftedNum, sigma);
+
+    // the dividend is cut to blocks of n limbs, with room for one more bit
+    const limb_vector &numLimbs = shiftedNum._limbs;
+    size_t blocks = std::max(size_t(2), (_bitLength(numLimbs.data(), numLimbs.size()) +
+                                         n * LIMB_BITS) / (n * LIMB_BITS));
+    quotient.assign(blocks * n, 0);
+    big_integer current = _sliceLimbs(numLimbs.data(), numLimbs.size(), (blocks - 2) * n, 2 * n);
+    big_integer blockQuotient, blockRemainder;
+    for (size_t i = blocks - 1; i > 0; i--)
+    {
+        _divideTwoByOne(current, shiftedDivisor, n, blockQuotient, blockRemainder);
+        const limb_vector &blockLimbs = blockQuotient._limbs;
+        std::copy(blockLimbs.begin(), blockLimbs.end(), quotient.begin() + (i - 1) * n);
+        if (i > 1)
+        {
+            current = _shiftedLeft(blockRemainder, n * LIMB_BITS) +
+                      _sliceLimbs(numLimbs.data(), numLimbs.size(), (i - 2) * n, n);
+        }
+    }
+    _normalize(quotient);
+    remainder = _shiftedRight(blockRemainder, sigma)._limbs;
 }
 
 /**
- * comapre this to other using <=
- * @param other big_integer
- * @return true if this <= other, false otherwise.
+ * divide a 2n limb number by an n limb number, the top bit of the divisor must be set
+ * and num must be below divisor * B^n.
+ * @param num the dividend
+ * @param divisor the divisor
+ * @param n the length of the divisor
+ * @param quotient output, num / divisor
+ * @param remainder output, num % divisor
  */
-bool big_integer::operator<=(const big_integer &other) const
+void big_integer::_divideTwoByOne(const big_integer &num, const big_integer &divisor, size_t n,
+                                  big_integer &quotient, big_integer &remainder)
 {
-    return !((*this) > other);
+    if (n % 2 != 0 || n < BURNIKEL_ZIEGLER_THRESHOLD)
+    {
+        _divideBasecase(num._limbs, divisor._limbs, quotient._limbs, remainder._limbs);
+        return;
+    }
+    // num = [a1, a2, a3, a4] in blocks of half, divide [a1, a2, a3] and then [r, a4]
+    size_t half = n / 2;
+    const limb_vector &limbs = num._limbs;
+    big_integer upper = _sliceLimbs(limbs.data(), limbs.size(), half, 3 * half);
+    big_integer upperQuotient, upperRemainder;
+    _divideThreeByTwo(upper, divisor, half, upperQuotient, upperRemainder);
+    big_integer lower = _shiftedLeft(upperRemainder, half * LIMB_BITS) +
+                        _sliceLimbs(limbs.data(), limbs.size(), 0, half);
+    _divideThreeByTwo(lower, divisor, half, quotient, remainder);
+    quotient = _shiftedLeft(upperQuotient, half * LIMB_BITS) + quotient;
 }
 
 /**
- * add num1 and num2 and return the result
- * @param num1 big_integer
- * @param num2 big_integer
- * @return sum of num1 and num2
+ * divide a 3 * half limb number by a 2 * half limb number, same requirements as
+ * _divideTwoByOne
+ * @param num the dividend
+ * @param divisor the divisor
+ * @param half half the length of the divisor
+ * @param quotient output, num / divisor
+ * @param remainder output, num % divisor
  */
-string big_integer::_add(const string &num1, const string &num2) const
+void big_integer::_divideThreeByTwo(const big_integer &num, const big_integer &divisor,
+                                    size_t half, big_integer &quotient, big_integer &remainder)
 {
-    unsigned long maxLen = std::max(num1.length(), num2.length());
-    unsigned long i = 0;
-    int num = 0;
-    int carry = 0;
-    string result = "";
-    for (; i < maxLen; i++)
+    // num = [a1, a2, a3], divisor = [b1, b2], all in blocks of half
+    const limb_vector &limbs = num._limbs, &divLimbs = divisor._limbs;
+    big_integer b1 = _sliceLimbs(divLimbs.data(), divLimbs.size(), half, half);
+    big_integer b2 = _sliceLimbs(divLimbs.data(), divLimbs.size(), 0, half);
+    big_integer a12 = _sliceLimbs(limbs.data(), limbs.size(), half, 2 * half);
+    big_integer a1 = _sliceLimbs(limbs.data(), limbs.size(), 2 * half, half);
+    big_integer partial;
+    // estimate the quotient from [a1, a2] / b1
+    if (a1 < b1)
     {
-        num = _getDigit(num1, i) + _getDigit(num2, i) + carry;
-        if (num >= 10)
-        {
-            num -= 10;
-            carry = 1;
-        }
-        else
-        {
-            carry = 0;
-        }
-        result += (char(num + '0'));
+        _divideTwoByOne(a12, b1, half, quotient, partial);
     }
-    if (carry == 1)
+    else
     {
-        result += "1";
+        // the quotient is B^half - 1 and the remainder [a1, a2] - b1 * (B^half - 1)
+        quotient._limbs.assign(half, ~limb_t(0));
+        partial = a12 - _shiftedLeft(b1, half * LIMB_BITS) + b1;
     }
-    if (result.empty())
+    // the estimate is at most 2 too large, fix it with the low part of the divisor
+    big_integer correction = quotient * b2;
+    remainder = _shiftedLeft(partial, half * LIMB_BITS) +
+                _sliceLimbs(limbs.data(), limbs.size(), 0, half);
+    const big_integer one = big_integer(1);
+    while (remainder < correction)
     {
-        return "0";
+        remainder = remainder + divisor;
+        quotient = quotient - one;
     }
-    return result;
+    remainder = remainder - correction;
 }
 
 /**
- * substract num2 from num1
- * @param num1 a nubmer
- * @param num2 a number
- * @return num1 - num2
+ * schoolbook long division (knuth's algorithm D), one quotient limb per step.
+ * divisor must be normalized with at least 2 limbs and len >= divLen.
+ * @param quotient output of len - divLen + 1 limbs
+ * @param remainder output of divLen limbs
+ * @param num the dividend
+ * @param len length of num
+ * @param divisor the divisor
+ * @param divLen length of divisor
  */
-string big_integer::_substract(const string &num1, const string &num2) const
+void big_integer::_divideKnuth(limb_t *quotient, limb_t *remainder, const limb_t *num, size_t len,
+                               const limb_t *divisor, size_t divLen)
 {
-    string res = "";
-    int carry = 0;
-    unsigned long maxLen = std::max(num1.length(), num2.length());
-    for (unsigned long i = 0; i < maxLen; i++)
+    // shift both numbers so the top bit of the divisor is set, this keeps every
+    // estimated quotient limb at most 2 above the real one
+    int shift = __builtin_clzll(divisor[divLen - 1]);
+    limb_vector shiftedNum(len + 1), shiftedDivisor(divLen);
+    limb_t *u = shiftedNum.data(), *v = shiftedDivisor.data();
+    _shiftLeftBits(v, divisor, divLen, shift);
+    u[len] = _shiftLeftBits(u, num, len, shift);
+
+    const dlimb_t base = dlimb_t(1) << LIMB_BITS;
+    limb_t vTop = v[divLen - 1], vNext = v[divLen - 2];
+    for (size_t j = len - divLen + 1; j-- > 0;)
     {
-        // _substract digits
-        int sub = _getDigit(num1, i) - _getDigit(num2, i) - carry;
-        // if negative, make it positive
-        if (sub < 0)
+        // estimate the quotient limb from the top two limbs, then refine with the third
+        dlimb_t top = (dlimb_t(u[j + divLen]) << LIMB_BITS) | u[j + divLen - 1];
+        dlimb_t qHat = top / vTop, rHat = top % vTop;
+        while (qHat >= base || qHat * vNext > ((rHat << LIMB_BITS) | u[j + divLen - 2]))
         {
-            sub += 10;
-            carry = 1;
+            qHat--;
+            rHat += vTop;
+            if (rHat >= base)
+            {
+                break;
+            }
         }
-        else
+
+        // u[j .. j + divLen] -= qHat * v
+        limb_t borrow = _substractMultiplyRow(u + j, v, divLen, limb_t(qHat));
+        bool negative = u[j + divLen] < borrow;
+        u[j + divLen] -= borrow;
+
+        // the estimate was one too large, add the divisor back
+        if (negative)
         {
-            carry = 0;
+            qHat--;
+            u[j + divLen] += _add(u + j, u + j, divLen, v, divLen);
         }
-        res += char(sub + '0');
-    }
-    if (res.empty())
-    {
-        return "0";
+        quotient[j] = limb_t(qHat);
     }
-    return _removeZeros(res);
+
+    // the remainder is the low part of u shifted back
+    _shiftRightBits(u, u, divLen + 1, shift);
+    std::copy(u, u + divLen, remainder);
 }
 
 /**
- * get digit at index
- * @param index the index of the of the digit
- * @return the digit at place index.
+ * shift a magnitude left by less than a limb, result may alias num
+ * @param result output of len limbs
+ * @param num a number
+ * @param len length of num
+ * @param shift number of bits to shift, below 64
+ * @return the bits shifted out of the most significant limb
  */
-int big_integer::_getDigit(const string &number, unsigned long index) const
+big_integer::limb_t big_integer::_shiftLeftBits(limb_t *result, const limb_t *num, size_t len,
+                                                int shift)
 {
-    if (index >= number.length())
+    if (shift == 0)
     {
+        std::copy(num, num + len, result);
         return 0;
     }
-    return number[index] - '0';
-}
-
-/**
- * remove unwanted zeros at the end of a number
- * @param num a number
- * @return number without zeros at the end
- */
-string big_integer::_removeZeros(string &num) const
-{
-    while (num[num.length() - 1] == '0' && num.length() > 1)
+    limb_t out = 0;
+    for (size_t i = 0; i < len; i++)
     {
-        num.pop_back();
+        limb_t cur = num[i];
+        result[i] = (cur << shift) | out;
+        out = cur >> (LIMB_BITS - shift);
     }
-    return num;
+    return out;
 }
 
 /**
- * multiplication of integers
- * @param num1 big_integer
- * @param num2 big_integer
- * @return num1 * num2
+ * shift a magnitude right by less than a limb, result may alias num
+ * @param result output of len limbs
+ * @param num a number
+ * @param len length of num
+ * @param shift number of bits to shift, below 64
  */
-big_integer big_integer::_multiplication(const big_integer &num1, const big_integer &num2)
+void big_integer::_shiftRightBits(limb_t *result, const limb_t *num, size_t len, int shift)
 {
-    // dir = direction (positive to zero or negative to zero), res = result
-    big_integer res = big_integer(), dir, zero = big_integer();
-    big_integer smaller = big_integer(num1), larger = big_integer(num2);
-    dir = big_integer("-1");
-    // smaller than zero
-    if (smaller < zero)
+    if (shift == 0)
     {
-        dir = big_integer("1");
+        std::copy(num, num + len, result);
+        return;
     }
-    // calculate _multiplication
-    while (smaller != zero)
+    for (size_t i = 0; i < len; i++)
     {
-        res = res + larger;
-        smaller = smaller + dir;
+        limb_t high = i + 1 < len ? num[i + 1] << (LIMB_BITS - shift) : 0;
+        result[i] = (num[i] >> shift) | high;
     }
-    res._isPositive = true;
-    return res;
 }
 
 /**
@@ -616,59 +4801,66 @@ big_integer big_integer::_multiplication(const big_integer &num1, const big_inte
  */
 big_integer big_integer::division(const big_integer &num1, const big_integer &num2)
 {
-    big_integer zero = big_integer(), res = big_integer(), one = big_integer("1");
-    if (num2 == zero)
-    {
-        return zero;
-    }
-    big_integer numOneCpy = big_integer(num1), numTwoCpy = big_integer(num2);
-    numOneCpy._isPositive = true;
-    numTwoCpy._isPositive = true;
-    big_integer temp;
-    // divide
-    while (numOneCpy > zero)
+    big_integer res;
+    if (num2._limbs.empty())
     {
-        temp = numOneCpy - numTwoCpy;
-        if (temp >= zero)
-        {
-            res = res + one;
-        }
-        numOneCpy = temp;
+        return res;
     }
-    res._isPositive = true;
+    limb_vector remainder;
+    _divideMagnitude(num1._limbs, num2._limbs, res._limbs, remainder);
     return res;
 }
 
+/**
+ * get the thresholds used to pick a multiplication algorithm
+ * @return the current thresholds
+ */
+big_integer::multiplication_thresholds big_integer::get_multiplication_thresholds()
+{
+    return _multiplicationThresholds;
+}
 
 /**
- * set larger and smaller (length of number)
- * @param num1 big_integer
- * @param num2 big_integer
- * @param larger big_integer
- * @param smaller big_integer
+ * set the thresholds used to pick a multiplication algorithm, meant to be
+ * calibrated once per machine before any multiplication runs.
+ * karatsuba and toom-3 thresholds below 4 limbs are raised to 4, since smaller splits
+ * do not shrink.
+ * @param thresholds the new thresholds
  */
-void big_integer::_setLargerAndSmaller(const big_integer &num1, const big_integer &num2,
-                                      big_integer &larger, big_integer &smaller)
+void big_integer::set_multiplication_thresholds(const multiplication_thresholds &thresholds)
 {
-    if (num2._data.length() < num1._data.length())
-    {
-        smaller = big_integer(num2);
-        larger = big_integer(num1);
-    }
-    else
-    {
-        smaller = big_integer(num1);
-        larger = big_integer(num2);
-    }
+    _multiplicationThresholds = thresholds;
+    _multiplicationThresholds.karatsuba = std::max(thresholds.karatsuba, MIN_SPLIT_THRESHOLD);
+    _multiplicationThresholds.toom3 = std::max(thresholds.toom3, MIN_SPLIT_THRESHOLD);
+}
+
+/**
+ * get the thread cap and the length from which multiplications run in parallel
+ * @return the current parallelism
+ */
+big_integer::multiplication_parallelism big_integer::get_multiplication_parallelism()
+{
+    return _multiplicationParallelism;
 }
 
 /**
- * return abs value of current integer
- * @return abs value of current integer
+ * set the thread cap and the length from which multiplications run in parallel, meant to
+ * be called once before any multiplication runs. it starts (or stops) the worker threads,
+ * parallelism is off (a single thread) by default.
+ * @param parallelism the new parallelism
  */
-big_integer big_integer::_absValue(big_integer num) const
+void big_integer::set_multiplication_parallelism(const multiplication_parallelism &parallelism)
 {
-    big_integer abs = big_integer(num);
-    abs._isPositive = true;
-    return abs;
-}
\ No newline at end of file
+    unsigned int threads = parallelism.threads;
+    if (threads == 0)
+    {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    // the old workers are joined before the new ones start
+    multiplicationPool.reset();
+    if (threads > 1)
+    {
+        multiplicationPool.reset(new task_pool(threads));
+    }
+    _multiplicationParallelism = {threads, parallelism.threshold};
+}
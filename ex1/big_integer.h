@@ -2,22 +2,79 @@
 #define EX1_BIG_INTEGER_H
 
 #include <iostream>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <atomic>
+#include <functional>
+#include <type_traits>
+#include <vector>
+#include "limb_vector.h"
 
 using std::string;
 using std::ostream;
 
 /**
- * this class represents a big integer
+ * this class represents a big integer.
+ * the magnitude is kept in binary limbs (base 2^64, least significant limb first),
+ * decimal text is only produced or consumed by the string constructor and operator<<.
+ * values up to 128 bits are stored inline and computed with native arithmetic.
  * @author Idan Yamin
  * @class big_integer
  */
 class big_integer
 {
 public:
+    /* a single digit of the magnitude in base 2^64 */
+    typedef std::uint64_t limb_t;
+
+    /**
+     * operand lengths (in limbs) from which multiplication switches to a faster algorithm.
+     * the shorter operand decides, operands below karatsuba use the schoolbook method.
+     * @struct multiplication_thresholds
+     */
+    struct multiplication_thresholds
+    {
+        /* smallest length multiplied with karatsuba */
+        size_t karatsuba;
+        /* smallest length multiplied with toom-3 */
+        size_t toom3;
+        /* smallest length multiplied with the number theoretic transform */
+        size_t ntt;
+    };
+
+    /**
+     * how a single multiplication spreads over threads. above the threshold the karatsuba
+     * and toom-3 sub-products and the number theoretic transforms run as tasks of a shared
+     * work stealing pool, below it everything stays on the calling thread.
+     * @struct multiplication_parallelism
+     */
+    struct multiplication_parallelism
+    {
+        /* most threads working on multiplications, the callers included. 1 keeps every
+         * multiplication on its calling thread, 0 means one per hardware thread */
+        unsigned int threads;
+        /* smallest length (in limbs) of the shorter operand that is split across threads */
+        size_t threshold;
+    };
+
+    /**
+     * the 64 bit type a native integer operand is widened to, keeping its signedness.
+     * only defined for the integer types of at most 64 bits other than bool, so the native
+     * overloads below drop out for any other type.
+     * @tparam Word a native integer type
+     */
+    template<class Word>
+    using native_word = typename std::enable_if<
+            std::is_integral<Word>::value && !std::is_same<Word, bool>::value &&
+            sizeof(Word) <= sizeof(limb_t),
+            typename std::conditional<std::is_signed<Word>::value, std::int64_t,
+                                      std::uint64_t>::type>::type;
+
     /**
      * default constructor, create a 0 big_integer
      */
-    big_integer() : _data("0"), _isPositive(true)
+    big_integer() : _limbs(), _isPositive(true), _hash(0)
     {};
 
     /**
@@ -26,6 +83,29 @@ public:
     */
     big_integer(int number);
 
+    /**
+     * construct a big number out of any other native integer of at most 64 bits, such as
+     * int64_t or uint64_t
+     * @param number a number
+     */
+    template<class Word, class = native_word<Word>>
+    big_integer(Word number) : big_integer()
+    {
+        _addWord(*this, *this, native_word<Word>(number), false);
+    }
+
+    /**
+     * construct a big number out of a signed 128 bit integer
+     * @param number a number
+     */
+    big_integer(__int128 number);
+
+    /**
+     * construct a big number out of an unsigned 128 bit integer
+     * @param number a number
+     */
+    big_integer(unsigned __int128 number);
+
     /**
      * constructor
      * @param number a string representation of number
@@ -38,6 +118,35 @@ public:
      */
     big_integer(const big_integer &bigNum);
 
+    /**
+     * move constructor, takes the limbs of bigNum and leaves it 0
+     * @param bigNum an integer
+     */
+    big_integer(big_integer &&bigNum) noexcept;
+
+    /**
+     * convert to a native integer of at most 64 bits. like a conversion between native
+     * integers, a number out of range keeps its low bits (of the two's complement).
+     * @return the number modulo 2^(bits of Word)
+     */
+    template<class Word, class = native_word<Word>>
+    explicit operator Word() const
+    {
+        return Word(_lowBits());
+    }
+
+    /**
+     * convert to a signed 128 bit integer, keeping the low 128 bits of the two's complement
+     * @return the number modulo 2^128
+     */
+    explicit operator __int128() const;
+
+    /**
+     * convert to an unsigned 128 bit integer, keeping the low 128 bits of the two's complement
+     * @return the number modulo 2^128
+     */
+    explicit operator unsigned __int128() const;
+
     /**
      * put this big_integer in stream
      * @param output the stream
@@ -46,19 +155,73 @@ public:
      */
     friend ostream &operator<<(ostream &output, const big_integer &num);
 
+    /* the engine of the lazy expressions in big_integer_expr.h works on the limbs directly */
+    friend class big_integer_accumulator;
+
+    /* modulus_context.h runs the modular kernels on its precomputed constants */
+    friend class modulus_context;
+
+    /* basic_big_integer.h converts through the subquadratic decimal conversions */
+    friend class decimal_big_integer;
+
+    /* big_integer_view.h reads serialized numbers in place */
+    friend class big_integer_view;
+
     /**
      * adds this to other and return the result
      * @param other big_integer
      * @return this + other
      */
-    big_integer operator+(const big_integer &other) const;
+    big_integer operator+(const big_integer &other) const &;
+
+    /**
+     * adds this expiring integer to other, reusing the storage of this
+     * @param other big_integer
+     * @return this + other
+     */
+    big_integer operator+(const big_integer &other) &&;
+
+    /**
+     * adds this to an expiring other, reusing the storage of other
+     * @param other big_integer
+     * @return this + other
+     */
+    big_integer operator+(big_integer &&other) const &;
+
+    /**
+     * adds two expiring integers, reusing the storage of this
+     * @param other big_integer
+     * @return this + other
+     */
+    big_integer operator+(big_integer &&other) &&;
 
     /**
      * return this - other
      * @param other big_integer
      * @return this - other
      */
-    big_integer operator-(const big_integer &other) const;
+    big_integer operator-(const big_integer &other) const &;
+
+    /**
+     * substract other from this expiring integer, reusing the storage of this
+     * @param other big_integer
+     * @return this - other
+     */
+    big_integer operator-(const big_integer &other) &&;
+
+    /**
+     * substract an expiring other from this, reusing the storage of other
+     * @param other big_integer
+     * @return this - other
+     */
+    big_integer operator-(big_integer &&other) const &;
+
+    /**
+     * substract two expiring integers, reusing the storage of this
+     * @param other big_integer
+     * @return this - other
+     */
+    big_integer operator-(big_integer &&other) &&;
 
     /**
      * this function calculate this   other
@@ -110,11 +273,317 @@ public:
     big_integer operator%(const big_integer &other) const;
 
     /**
-    * default = operator
+     * add a native integer in one pass over the limbs
+     * @param other a native integer of at most 64 bits
+     * @return this + other
+     */
+    template<class Word, class = native_word<Word>>
+    big_integer operator+(Word other) const &
+    {
+        big_integer res;
+        _addWord(res, *this, native_word<Word>(other), false);
+        return res;
+    }
+
+    /**
+     * add a native integer to this expiring integer in place
+     * @param other a native integer of at most 64 bits
+     * @return this + other
+     */
+    template<class Word, class = native_word<Word>>
+    big_integer operator+(Word other) &&
+    {
+        _addWord(*this, *this, native_word<Word>(other), false);
+        return std::move(*this);
+    }
+
+    /**
+     * substract a native integer in one pass over the limbs
+     * @param other a native integer of at most 64 bits
+     * @return this - other
+     */
+    template<class Word, class = native_word<Word>>
+    big_integer operator-(Word other) const &
+    {
+        big_integer res;
+        _addWord(res, *this, native_word<Word>(other), true);
+        return res;
+    }
+
+    /**
+     * substract a native integer from this expiring integer in place
+     * @param other a native integer of at most 64 bits
+     * @return this - other
+     */
+    template<class Word, class = native_word<Word>>
+    big_integer operator-(Word other) &&
+    {
+        _addWord(*this, *this, native_word<Word>(other), true);
+        return std::move(*this);
+    }
+
+    /**
+     * multiply by a native integer in one pass over the limbs
+     * @param other a native integer of at most 64 bits
+     * @return this * other
+     */
+    template<class Word, class = native_word<Word>>
+    big_integer operator*(Word other) const
+    {
+        big_integer res;
+        _multiplyWord(res, *this, native_word<Word>(other));
+        return res;
+    }
+
+    /**
+     * divide by a native integer in one pass over the limbs, with the semantics of
+     * operator/(const big_integer &)
+     * @param other a native integer of at most 64 bits
+     * @return this / other
+     */
+    template<class Word, class = native_word<Word>>
+    big_integer operator/(Word other) const
+    {
+        big_integer res;
+        _divideWord(&res, nullptr, *this, native_word<Word>(other));
+        return res;
+    }
+
+    /**
+     * remainder of a native integer in one pass over the limbs, with the semantics of
+     * operator%(const big_integer &)
+     * @param other a native integer of at most 64 bits
+     * @return this % other
+     */
+    template<class Word, class = native_word<Word>>
+    big_integer operator%(Word other) const
+    {
+        big_integer res;
+        _divideWord(nullptr, &res, *this, native_word<Word>(other));
+        return res;
+    }
+
+    /**
+     * assigns this + other to this
+     * @param other a native integer of at most 64 bits
+     * @return this after doing this += other
+     */
+    template<class Word, class = native_word<Word>>
+    big_integer &operator+=(Word other)
+    {
+        _addWord(*this, *this, native_word<Word>(other), false);
+        return *this;
+    }
+
+    /**
+     * assigns this - other to this
+     * @param other a native integer of at most 64 bits
+     * @return this after doing this -= other
+     */
+    template<class Word, class = native_word<Word>>
+    big_integer &operator-=(Word other)
+    {
+        _addWord(*this, *this, native_word<Word>(other), true);
+        return *this;
+    }
+
+    /**
+     * assigns this * other to this
+     * @param other a native integer of at most 64 bits
+     * @return this after doing this *= other
+     */
+    template<class Word, class = native_word<Word>>
+    big_integer &operator*=(Word other)
+    {
+        _multiplyWord(*this, *this, native_word<Word>(other));
+        return *this;
+    }
+
+    /**
+     * assigns this / other to this
+     * @param other a native integer of at most 64 bits
+     * @return this after doing this /= other
+     */
+    template<class Word, class = native_word<Word>>
+    big_integer &operator/=(Word other)
+    {
+        _divideWord(this, nullptr, *this, native_word<Word>(other));
+        return *this;
+    }
+
+    /**
+     * shift left
+     * @param bits number of bits to shift
+     * @return this * 2^bits
+     */
+    big_integer operator<<(size_t bits) const;
+
+    /**
+     * assigns this << bits to this
+     * @param bits number of bits to shift
+     * @return this after shifting
+     */
+    big_integer &operator<<=(size_t bits);
+
+    /**
+     * arithmetic shift right, a negative number rounds towards minus infinity like its two's
+     * complement would
+     * @param bits number of bits to shift
+     * @return floor(this / 2^bits)
+     */
+    big_integer operator>>(size_t bits) const;
+
+    /**
+     * assigns this >> bits to this
+     * @param bits number of bits to shift
+     * @return this after shifting
+     */
+    big_integer &operator>>=(size_t bits);
+
+    /**
+     * bitwise and, a negative number acts as its two's complement with infinitely many
+     * leading ones, like for the rest of the bitwise operators
+     * @param other big_integer
+     * @return this & other
+     */
+    big_integer operator&(const big_integer &other) const;
+
+    /**
+     * assigns this & other to this
+     * @param other big_integer
+     * @return this after doing this & other
+     */
+    big_integer &operator&=(const big_integer &other);
+
+    /**
+     * bitwise or
+     * @param other big_integer
+     * @return this | other
+     */
+    big_integer operator|(const big_integer &other) const;
+
+    /**
+     * assigns this | other to this
+     * @param other big_integer
+     * @return this after doing this | other
+     */
+    big_integer &operator|=(const big_integer &other);
+
+    /**
+     * bitwise xor
+     * @param other big_integer
+     * @return this ^ other
+     */
+    big_integer operator^(const big_integer &other) const;
+
+    /**
+     * assigns this ^ other to this
+     * @param other big_integer
+     * @return this after doing this ^ other
+     */
+    big_integer &operator^=(const big_integer &other);
+
+    /**
+     * bitwise not
+     * @return ~this, which is -this - 1
+     */
+    big_integer operator~() const;
+
+    /**
+     * @return the number of bits of the magnitude, 0 for 0
+     */
+    size_t bit_length() const;
+
+    /**
+     * @return the number of set bits of the magnitude
+     */
+    size_t popcount() const;
+
+    /**
+     * read a bit of the two's complement, so every bit far enough up of a negative number is 1
+     * @param index the bit, 0 is the least significant
+     * @return true if the bit is set
+     */
+    bool test_bit(size_t index) const;
+
+    /**
+    * = operator
+    * @param other the other big_integer
+    * @return this integer after copying other
+    */
+    big_integer &operator=(const big_integer &other);
+
+    /**
+    * move = operator, takes the limbs of other and leaves it 0
     * @param other the other big_integer
-    * @return this integer after shallow copy from other
+    * @return this integer
+    */
+    big_integer &operator=(big_integer &&other) noexcept;
+
+    /**
+    * three way comparison, scans the limbs from the most significant end
+    * @param other the number to compare to
+    * @return -1 if this < other, 0 if they are equal, 1 if this > other
+    */
+    int compare(const big_integer &other) const;
+
+    /**
+    * hash the sign and the limbs a word at a time. the value is computed on the first call and
+    * kept in the object until it changes, later calls cost O(1).
+    * @return the hash of this number
     */
-    big_integer &operator=(const big_integer &other) = default;
+    size_t hash() const;
+
+    /**
+    * @return the length in bytes of the sort key of this number
+    */
+    size_t sort_key_size() const;
+
+    /**
+    * write a binary key that orders like the number under memcmp: a sign byte, the limb count
+    * and the magnitude, all big endian, with the count and magnitude inverted for negatives.
+    * keys of different lengths already differ in their first 9 bytes, so comparing the common
+    * prefix with memcmp and then the lengths orders any two keys.
+    * @param buffer output, must have room for sort_key_size() bytes
+    * @return the number of bytes written
+    */
+    size_t sort_key(unsigned char *buffer) const;
+
+    /**
+    * @return the sort key of this number as a byte string, see sort_key(unsigned char *)
+    */
+    string sort_key() const;
+
+    /**
+    * @return the length in bytes of the binary encoding of this number
+    */
+    size_t serialized_size() const;
+
+    /**
+    * write the compact binary encoding of this number: a version byte, the limb count as a
+    * varint (7 bits per byte, least significant first), a sign byte and the limbs, least
+    * significant first, 8 little endian bytes each. it is read back by deserialize, or in
+    * place by big_integer_view.
+    * @param buffer output, must have room for serialized_size() bytes
+    * @return the number of bytes written
+    */
+    size_t serialize(unsigned char *buffer) const;
+
+    /**
+    * @return the binary encoding of this number as a byte string, see
+    * serialize(unsigned char *)
+    */
+    string serialize() const;
+
+    /**
+    * read a number written by serialize
+    * @param buffer the encoding
+    * @param size number of bytes available in buffer, it may hold more after the encoding
+    * @param num output, 0 if the encoding is invalid
+    * @return the number of bytes read, 0 if the encoding is truncated, has an unknown
+    * version or is not normalized
+    */
+    static size_t deserialize(const unsigned char *buffer, size_t size, big_integer &num);
 
     /**
     * compare to other big_integer for equality check.
@@ -166,63 +635,977 @@ public:
     */
     static big_integer division(const big_integer &num1, const big_integer &num2);
 
+    /**
+    * divide num1 by num2 once, getting both results of operator/ and operator%
+    * @param num1 the dividend
+    * @param num2 the divisor
+    * @return the pair (num1 / num2, num1 % num2)
+    */
+    static std::pair<big_integer, big_integer> divmod(const big_integer &num1,
+                                                      const big_integer &num2);
+
+    /**
+    * divide num1 by num2 once into caller provided outputs, reusing their storage.
+    * the outputs may be the inputs themselves but must be two different objects.
+    * @param num1 the dividend
+    * @param num2 the divisor
+    * @param quotient output, num1 / num2
+    * @param remainder output, num1 % num2
+    */
+    static void divmod(const big_integer &num1, const big_integer &num2, big_integer &quotient,
+                       big_integer &remainder);
+
+    /**
+    * modular exponentiation by montgomery multiplication and a sliding window over the
+    * exponent. the running time depends on the bits of the exponent, use
+    * powmod_constant_time when the exponent is secret.
+    * @param base the base, a negative base is taken as its non negative residue
+    * @param exponent the exponent, must not be negative
+    * @param modulus the modulus, its sign is ignored
+    * @return base^exponent mod |modulus| in [0, |modulus|), 0 if the modulus is 0 or the
+    * exponent is negative
+    */
+    static big_integer powmod(const big_integer &base, const big_integer &exponent,
+                              const big_integer &modulus);
+
+    /**
+    * modular exponentiation whose sequence of operations and memory accesses depends only on
+    * the lengths of the exponent and the modulus, not on their bits. every window of the
+    * exponent costs the same squarings and one multiplication by a table entry that is read
+    * with a full masked scan. the modulus must be odd for this guarantee, an even modulus is
+    * handled by division like powmod.
+    * @param base the base, a negative base is taken as its non negative residue
+    * @param exponent the exponent, must not be negative
+    * @param modulus the modulus, its sign is ignored
+    * @return base^exponent mod |modulus| in [0, |modulus|), 0 if the modulus is 0 or the
+    * exponent is negative
+    */
+    static big_integer powmod_constant_time(const big_integer &base, const big_integer &exponent,
+                                            const big_integer &modulus);
+
+    /**
+    * greatest common divisor. numbers of up to two limbs take the binary algorithm, longer
+    * ones lehmer's algorithm on the leading words, and long ones the subquadratic half gcd.
+    * @param num1 a number
+    * @param num2 a number
+    * @return gcd(|num1|, |num2|), 0 only if both are 0
+    */
+    static big_integer gcd(const big_integer &num1, const big_integer &num2);
+
+    /**
+    * least common multiple
+    * @param num1 a number
+    * @param num2 a number
+    * @return the smallest non negative common multiple, 0 if either number is 0
+    */
+    static big_integer lcm(const big_integer &num1, const big_integer &num2);
+
+    /**
+    * extended gcd, find bezout coefficients x and y with num1 * x + num2 * y = gcd.
+    * the outputs may be the inputs themselves but must be two different objects.
+    * @param num1 a number
+    * @param num2 a number
+    * @param x output, the coefficient of num1
+    * @param y output, the coefficient of num2
+    * @return gcd(|num1|, |num2|)
+    */
+    static big_integer gcd_extended(const big_integer &num1, const big_integer &num2,
+                                    big_integer &x, big_integer &y);
+
+    /**
+    * modular inverse
+    * @param num the number, a negative number is taken as its non negative residue
+    * @param modulus the modulus, its sign is ignored
+    * @return the x in [0, |modulus|) with num * x = 1 mod |modulus|, 0 if num and modulus are
+    * not coprime or |modulus| is at most 1
+    */
+    static big_integer mod_inverse(const big_integer &num, const big_integer &modulus);
+
+    /**
+    * square a number, about half the partial products of num * num. num * num picks
+    * this automatically.
+    * @param num a number
+    * @return num * num
+    */
+    static big_integer square(const big_integer &num);
+
+    /**
+    * integer square root
+    * @param num a number
+    * @return floor(sqrt(num)), 0 for a negative number
+    */
+    static big_integer isqrt(const big_integer &num);
+
+    /**
+    * integer k-th root by newton iteration with precision doubling: the root of the leading
+    * half of the digits, scaled back, is one newton step away from the root of num, so the
+    * whole computation costs a few multiplications and divisions of the full length.
+    * @param num a number
+    * @param k the degree of the root
+    * @return the k-th root of num rounded towards 0, 0 if k is 0 or k is even and num negative
+    */
+    static big_integer iroot(const big_integer &num, unsigned int k);
+
+    /**
+    * @param num a number
+    * @return true if num is the square of an integer
+    */
+    static bool is_perfect_square(const big_integer &num);
+
+    /**
+    * @param num a number
+    * @return true if num = r^k for some integers r and k >= 2
+    */
+    static bool is_perfect_power(const big_integer &num);
+
+    /**
+    * product of a range of numbers, multiplied pairwise in a balanced tree so the operands of
+    * every multiplication have about the same length and the fast algorithms apply
+    * @tparam Iterator an input iterator over big_integer, with std::move_iterator the numbers
+    * are moved instead of copied
+    * @param first the first number
+    * @param last past the last number
+    * @return the product, 1 for an empty range
+    */
+    template<class Iterator>
+    static big_integer product(Iterator first, Iterator last)
+    {
+        std::vector<big_integer> factors(first, last);
+        return _product(factors);
+    }
+
+    /**
+    * factorial by a product tree of the odd factors, the powers of 2 are one shift at the end
+    * @param n a number
+    * @return n!
+    */
+    static big_integer factorial(std::uint64_t n);
+
+    /**
+    * binomial coefficient, from its factorization into prime powers (legendre's formula)
+    * multiplied in a product tree. a small k against a huge n divides the product of the k
+    * top factors by k! instead, to save sieving up to n.
+    * @param n the size of the set
+    * @param k the size of the subsets
+    * @return n choose k, 0 if k > n
+    */
+    static big_integer binomial(std::uint64_t n, std::uint64_t k);
+
+    /**
+    * product of the primes up to n, sieved and multiplied in a product tree
+    * @param n a number
+    * @return n#, 1 if n < 2
+    */
+    static big_integer primorial(std::uint64_t n);
+
+    /**
+    * get the thresholds used to pick a multiplication algorithm
+    * @return the current thresholds
+    */
+    static multiplication_thresholds get_multiplication_thresholds();
+
+    /**
+    * set the thresholds used to pick a multiplication algorithm, meant to be
+    * calibrated once per machine before any multiplication runs.
+    * karatsuba and toom-3 thresholds below 4 limbs are raised to 4, since smaller splits
+    * do not shrink.
+    * @param thresholds the new thresholds
+    */
+    static void set_multiplication_thresholds(const multiplication_thresholds &thresholds);
+
+    /**
+    * get the thread cap and the length from which multiplications run in parallel
+    * @return the current parallelism
+    */
+    static multiplication_parallelism get_multiplication_parallelism();
+
+    /**
+    * set the thread cap and the length from which multiplications run in parallel, meant to
+    * be called once before any multiplication runs. it starts (or stops) the worker threads,
+    * parallelism is off (a single thread) by default.
+    * @param parallelism the new parallelism
+    */
+    static void set_multiplication_parallelism(const multiplication_parallelism &parallelism);
+
 private:
-    /* this data */
-    string _data;
+    /* the magnitude, least significant limb first, with no leading zero limbs (empty for 0) */
+    limb_vector _limbs;
 
     /* the sign of the number, true for positive false for negative */
     bool _isPositive;
 
+    /* the hash of the number, 0 until hash() computes it. every write to the number resets it */
+    mutable std::atomic<size_t> _hash;
+
+    /* the thresholds used by _multiply */
+    static multiplication_thresholds _multiplicationThresholds;
+
+    /* the thread cap and threshold of parallel multiplication */
+    static multiplication_parallelism _multiplicationParallelism;
+
     /**
-    * return abs value of current integer
-    * @return abs value of current integer
+    * multiply numbers in a balanced tree: every round multiplies neighbours pairwise
+    * @param factors the numbers, used as scratch
+    * @return their product, 1 if there are none
     */
-    big_integer _absValue(big_integer num) const;
+    static big_integer _product(std::vector<big_integer> &factors);
 
     /**
-    * get the string in reverse
-    * @param str string to reverse
-    * @return reversed string
+    * get the decimal digits of the magnitude (without sign)
+    * @return the magnitude in base 10
     */
-    string _getReversedString(const string &str) const;
+    string _toDecimalString() const;
 
     /**
-    * remove unwanted zeros from the end of a number
-    * @param num a number
-    * @return number without zeros at the end
+    * append the decimal digits of a positive number, splitting it recursively by
+    * the cached powers of 10. num must be below 10^(19 * 2^(level + 1)).
+    * @param num the number
+    * @param level the level of the power to split by
+    * @param padded true to pad with zeros to exactly 19 * 2^(level + 1) digits
+    * @param output the string to append to
+    */
+    static void _appendDecimal(const big_integer &num, size_t level, bool padded,
+                               string &output);
+
+    /**
+    * append the decimal digits of a magnitude one limb sized chunk at a time
+    * @param limbs a magnitude
+    * @param width pad with zeros to this many digits
+    * @param output the string to append to
     */
-    string _removeZeros(string &num) const;
+    static void _appendDecimalNaive(const limb_vector &limbs, size_t width, string &output);
 
     /**
-    * add num1 and num2 and return the result
+    * read a positive number out of decimal digits, splitting them recursively by
+    * the cached powers of 10
+    * @param digits the digits, all between '0' and '9'
+    * @param len the number of digits
+    * @return the number
+    */
+    static big_integer _parseDecimal(const char *digits, size_t len);
+
+    /**
+    * get a cached power of 10, computed once by repeated squaring and then reused
+    * @param level the level of the power
+    * @return 10^(19 * 2^level)
+    */
+    static const big_integer &_decimalPower(size_t level);
+
+    /**
+    * signed addition result = num1 + num2 (or num1 - num2), result may be num1 or num2
+    * so the sum is computed in place in the storage of an existing operand
+    * @param result output
     * @param num1 big_integer
     * @param num2 big_integer
-    * @return sum of num1 and num2
+    * @param negate2 true to substract num2 instead of adding it
+    */
+    static void _addSigned(big_integer &result, const big_integer &num1, const big_integer &num2,
+                           bool negate2);
+
+    /**
+     * a native integer operand split to a magnitude and a sign
+     * @struct word_operand
+     */
+    struct word_operand
+    {
+        /* the absolute value */
+        limb_t magnitude;
+        /* true for a negative value */
+        bool negative;
+
+        /**
+        * @param word a signed word
+        */
+        word_operand(std::int64_t word)
+                : magnitude(word < 0 ? limb_t(0) - limb_t(word) : limb_t(word)), negative(word < 0)
+        {};
+
+        /**
+        * @param word an unsigned word
+        */
+        word_operand(std::uint64_t word) : magnitude(word), negative(false)
+        {};
+    };
+
+    /**
+    * signed addition of a native word, result = num + word (or num - word), result may be num
+    * @param result output
+    * @param num big_integer
+    * @param word the native operand
+    * @param negate true to substract word instead of adding it
+    */
+    static void _addWord(big_integer &result, const big_integer &num, const word_operand &word,
+                         bool negate);
+
+    /**
+    * result = num * word, result may be num
+    * @param result output
+    * @param num big_integer
+    * @param word the native operand
+    */
+    static void _multiplyWord(big_integer &result, const big_integer &num,
+                              const word_operand &word);
+
+    /**
+    * divide by a native word with the semantics of divmod, the outputs may be num
+    * @param quotient output, num / word, or nullptr if not needed
+    * @param remainder output, num % word, or nullptr if not needed
+    * @param num the dividend
+    * @param word the native divisor
+    */
+    static void _divideWord(big_integer *quotient, big_integer *remainder, const big_integer &num,
+                            const word_operand &word);
+
+    /**
+    * @return the low 64 bits of the two's complement of this number
+    */
+    limb_t _lowBits() const;
+
+    /**
+    * write a 64 bit word most significant byte first
+    * @param out the output bytes
+    * @param word the word
+    * @return the position after the written bytes
     */
-    string _add(const string &num1, const string &num2) const;
+    static unsigned char *_writeBigEndian(unsigned char *out, std::uint64_t word);
 
     /**
-    * substract num2 from num1
-    * @param num1 a nubmer
+    * check a binary encoding of serialize and read its header
+    * @param buffer the encoding
+    * @param size number of bytes available in buffer
+    * @param count output, the number of limbs
+    * @param negative output, the sign
+    * @return the length of the header, the limbs follow it. 0 if the encoding is invalid
+    */
+    static size_t _readSerialHeader(const unsigned char *buffer, size_t size, size_t &count,
+                                    bool &negative);
+
+    /**
+    * read limbs stored as 8 little endian bytes each, at any alignment
+    * @param limbs output
+    * @param bytes the stored limbs
+    * @param count number of limbs
+    */
+    static void _readLimbs(limb_t *limbs, const unsigned char *bytes, size_t count);
+
+    /**
+    * remove unwanted zero limbs from the end of a number
+    * @param limbs a magnitude
+    */
+    static void _normalize(limb_vector &limbs);
+
+    /**
+    * add num1 and num2 into result, num1 must be at least as long as num2.
+    * result must have room for len1 limbs and may alias num1 or num2.
+    * @param result the output limbs
+    * @param num1 the longer number
+    * @param len1 length of num1
+    * @param num2 the shorter number
+    * @param len2 length of num2
+    * @return the carry out of the most significant limb
+    */
+    static limb_t _add(limb_t *result, const limb_t *num1, size_t len1, const limb_t *num2,
+                       size_t len2);
+
+    /**
+    * substract num2 from num1 into result, num1 must be at least as long as num2.
+    * result must have room for len1 limbs and may alias num1 or num2.
+    * @param result the output limbs
+    * @param num1 a number
+    * @param len1 length of num1
     * @param num2 a number
-    * @return num1 - num2
+    * @param len2 length of num2
+    * @return the borrow out of the most significant limb (1 if num2 > num1)
     */
-    string _substract(const string &num1, const string &num2) const;
+    static limb_t _substract(limb_t *result, const limb_t *num1, size_t len1,
+                             const limb_t *num2, size_t len2);
 
     /**
-    * get digit at index
-    * @param index the index of the of the digit
-    * @return the digit at place index.
+    * compare two normalized magnitudes
+    * @param num1 a number
+    * @param len1 length of num1
+    * @param num2 a number
+    * @param len2 length of num2
+    * @return negative if num1 < num2, 0 if equal, positive if num1 > num2
     */
-    int _getDigit(const string &number, unsigned long index) const;
+    static int _compareMagnitude(const limb_t *num1, size_t len1, const limb_t *num2,
+                                 size_t len2);
 
     /**
-    * multiplication of integers
-    * @param num1 big_integer
-    * @param num2 big_integer
-    * @return num1 * num2
+    * multiplication of magnitudes, result must have room for len1 + len2 limbs
+    * and must not alias the inputs. picks the algorithm by operand length.
+    * @param result the output limbs
+    * @param num1 a number
+    * @param len1 length of num1
+    * @param num2 a number
+    * @param len2 length of num2
+    */
+    static void _multiply(limb_t *result, const limb_t *num1, size_t len1, const limb_t *num2,
+                          size_t len2);
+
+    /**
+    * @param len length of the shorter operand of a product
+    * @return true if the product is long enough to split across threads
+    */
+    static bool _isParallel(size_t len);
+
+    /**
+    * schoolbook multiplication, same contract as _multiply
+    * @param result the output limbs
+    * @param num1 a number
+    * @param len1 length of num1
+    * @param num2 a number
+    * @param len2 length of num2
+    */
+    static void _multiplySchoolbook(limb_t *result, const limb_t *num1, size_t len1,
+                                    const limb_t *num2, size_t len2);
+
+    /**
+    * multiply num1 slice by slice with num2 and accumulate the partial products,
+    * same contract as _multiply
+    * @param result the output limbs
+    * @param num1 a number
+    * @param len1 length of num1
+    * @param num2 a number
+    * @param len2 length of num2
+    * @param sliceLen the length of the slices of num1
+    */
+    static void _multiplyBySlices(limb_t *result, const limb_t *num1, size_t len1,
+                                  const limb_t *num2, size_t len2, size_t sliceLen);
+
+    /**
+    * karatsuba multiplication, same contract as _multiply with len1 >= len2
+    * @param result the output limbs
+    * @param num1 a number
+    * @param len1 length of num1
+    * @param num2 a number
+    * @param len2 length of num2
+    */
+    static void _multiplyKaratsuba(limb_t *result, const limb_t *num1, size_t len1,
+                                   const limb_t *num2, size_t len2);
+
+    /**
+    * toom-3 multiplication, same contract as _multiply with len1 >= len2
+    * @param result the output limbs
+    * @param num1 a number
+    * @param len1 length of num1
+    * @param num2 a number
+    * @param len2 length of num2
+    */
+    static void _multiplyToom3(limb_t *result, const limb_t *num1, size_t len1,
+                               const limb_t *num2, size_t len2);
+
+    /**
+    * multiplication with a number theoretic transform over three word sized primes,
+    * the coefficients are recombined with the chinese remainder theorem.
+    * a square (num1 and num2 the same limbs) needs a single forward transform per prime.
+    * same contract as _multiply
+    * @param result the output limbs
+    * @param num1 a number
+    * @param len1 length of num1
+    * @param num2 a number
+    * @param len2 length of num2
+    */
+    static void _multiplyNtt(limb_t *result, const limb_t *num1, size_t len1,
+                             const limb_t *num2, size_t len2);
+
+    /**
+    * squaring of a magnitude, result must have room for 2 * len limbs and must not alias
+    * num. picks the algorithm by length with the thresholds of _multiply, except that the
+    * schoolbook square stays faster than karatsuba a bit longer.
+    * @param result the output limbs
+    * @param num a number
+    * @param len length of num
+    */
+    static void _square(limb_t *result, const limb_t *num, size_t len);
+
+    /**
+    * schoolbook squaring: every product num[i] * num[j] with i < j once, doubled, plus the
+    * squares of the limbs. same contract as _square
+    * @param result the output limbs
+    * @param num a number
+    * @param len length of num
+    */
+    static void _squareSchoolbook(limb_t *result, const limb_t *num, size_t len);
+
+    /**
+    * karatsuba squaring, three half sized squares. same contract as _square
+    * @param result the output limbs
+    * @param num a number
+    * @param len length of num
+    */
+    static void _squareKaratsuba(limb_t *result, const limb_t *num, size_t len);
+
+    /**
+    * toom-3 squaring, five third sized squares. same contract as _square
+    * @param result the output limbs
+    * @param num a number
+    * @param len length of num
+    */
+    static void _squareToom3(limb_t *result, const limb_t *num, size_t len);
+
+    /**
+    * evaluate the toom-3 polynomial of a number at 0, 1, -1, -2 and infinity
+    * @param num a number
+    * @param len length of num
+    * @param third the length of the coefficients
+    * @param points output, the five values
+    */
+    static void _toom3Evaluate(const limb_t *num, size_t len, size_t third, big_integer *points);
+
+    /**
+    * interpolate the toom-3 product polynomial from its values and add up its coefficients
+    * @param result output of fullLen limbs
+    * @param fullLen length of the product
+    * @param third the length of the coefficients
+    * @param values the product at 0, 1, -1, -2 and infinity, overwritten
+    */
+    static void _toom3Interpolate(limb_t *result, size_t fullLen, size_t third,
+                                  big_integer *values);
+
+    /**
+    * get the length of a magnitude without its leading zero limbs
+    * @param num a number
+    * @param len length of num
+    * @return the normalized length
+    */
+    static size_t _trimmedLength(const limb_t *num, size_t len);
+
+    /**
+    * build a positive big_integer out of a part of a magnitude
+    * @param num a number
+    * @param len length of num
+    * @param start index of the first limb of the part
+    * @param count number of limbs in the part, clamped to the end of num
+    * @return the part as a big_integer
+    */
+    static big_integer _sliceLimbs(const limb_t *num, size_t len, size_t start, size_t count);
+
+    /**
+    * shift a positive big_integer left
+    * @param num the number
+    * @param bits number of bits to shift
+    * @return num * 2^bits
+    */
+    static big_integer _shiftedLeft(const big_integer &num, size_t bits);
+
+    /**
+    * shift a positive big_integer right
+    * @param num the number
+    * @param bits number of bits to shift
+    * @return num / 2^bits
+    */
+    static big_integer _shiftedRight(const big_integer &num, size_t bits);
+
+    /**
+    * get the number of significant bits of a magnitude
+    * @param num a number
+    * @param len length of num
+    * @return the position of the highest set bit plus one, 0 for zero
+    */
+    static size_t _bitLength(const limb_t *num, size_t len);
+
+    /**
+    * get the number of trailing zero bits of a magnitude
+    * @param num a non zero number
+    * @param len length of num
+    * @return the position of the lowest set bit
+    */
+    static size_t _trailingZeroBits(const limb_t *num, size_t len);
+
+    /**
+    * apply a bitwise operation to the two's complements of two numbers, a limb at a time
+    * @param result output, may be one of the operands
+    * @param num1 a number
+    * @param num2 a number
+    * @param operation the operation on single limbs
+    */
+    template<class Operation>
+    static void _bitwise(big_integer &result, const big_integer &num1, const big_integer &num2,
+                         Operation operation);
+
+    /**
+    * add num * multiplier to result, in place
+    * @param result the accumulator, len limbs are updated
+    * @param num the number
+    * @param len length of num
+    * @param multiplier the limb to multiply by
+    * @return the limb carried out of result[len - 1]
+    */
+    static limb_t _addMultiplyRow(limb_t *result, const limb_t *num, size_t len, limb_t multiplier);
+
+    /**
+    * substract num * multiplier from result, in place
+    * @param result the accumulator, len limbs are updated
+    * @param num the number
+    * @param len length of num
+    * @param multiplier the limb to multiply by
+    * @return the limb borrowed from result[len]
+    */
+    static limb_t _substractMultiplyRow(limb_t *result, const limb_t *num, size_t len,
+                                       limb_t multiplier);
+
+    /**
+    * multiply num by a single limb and add a single limb
+    * @param result output of len limbs, may alias num
+    * @param num the number
+    * @param len length of num
+    * @param multiplier the limb to multiply by
+    * @param addend the limb to add
+    * @return the limb carried out of the most significant limb
+    */
+    static limb_t _multiplyAddSmall(limb_t *result, const limb_t *num, size_t len,
+                                    limb_t multiplier, limb_t addend);
+
+    /**
+    * divide num by a single limb, multiplying by a precomputed reciprocal of the divisor
+    * instead of dividing every limb
+    * @param result output of len limbs, may alias num, or nullptr for the remainder only
+    * @param num the number
+    * @param len length of num
+    * @param divisor a non zero limb
+    * @return the remainder
+    */
+    static limb_t _divideBySmall(limb_t *result, const limb_t *num, size_t len, limb_t divisor);
+
+    /**
+    * shift a magnitude left by less than a limb, result may alias num
+    * @param result output of len limbs
+    * @param num a number
+    * @param len length of num
+    * @param shift number of bits to shift, below 64
+    * @return the bits shifted out of the most significant limb
+    */
+    static limb_t _shiftLeftBits(limb_t *result, const limb_t *num, size_t len, int shift);
+
+    /**
+    * shift a magnitude right by less than a limb, result may alias num
+    * @param result output of len limbs
+    * @param num a number
+    * @param len length of num
+    * @param shift number of bits to shift, below 64
+    */
+    static void _shiftRightBits(limb_t *result, const limb_t *num, size_t len, int shift);
+
+    /**
+    * divide two magnitudes, the divisor must not be zero.
+    * the outputs must not be the same vectors as the inputs.
+    * @param num the dividend
+    * @param divisor the divisor
+    * @param quotient output, num / divisor
+    * @param remainder output, num % divisor
+    */
+    static void _divideMagnitude(const limb_vector &num, const limb_vector &divisor,
+                                 limb_vector &quotient, limb_vector &remainder);
+
+    /**
+    * divide two magnitudes without recursion (short division or knuth's algorithm D),
+    * same contract as _divideMagnitude
+    * @param num the dividend
+    * @param divisor the divisor
+    * @param quotient output, num / divisor
+    * @param remainder output, num % divisor
+    */
+    static void _divideBasecase(const limb_vector &num, const limb_vector &divisor,
+                                limb_vector &quotient, limb_vector &remainder);
+
+    /**
+    * recursive division (burnikel-ziegler) for large operands, cuts the dividend into
+    * blocks of the (padded) divisor length and divides them with _divideTwoByOne.
+    * same contract as _divideMagnitude
+    * @param num the dividend
+    * @param divisor the divisor
+    * @param quotient output, num / divisor
+    * @param remainder output, num % divisor
+    */
+    static void _divideBurnikelZiegler(const limb_vector &num, const limb_vector &divisor,
+                                       limb_vector &quotient, limb_vector &remainder);
+
+    /**
+    * divide a 2n limb number by an n limb number, the top bit of the divisor must be set
+    * and num must be below divisor * B^n.
+    * @param num the dividend
+    * @param divisor the divisor
+    * @param n the length of the divisor
+    * @param quotient output, num / divisor
+    * @param remainder output, num % divisor
+    */
+    static void _divideTwoByOne(const big_integer &num, const big_integer &divisor, size_t n,
+                                big_integer &quotient, big_integer &remainder);
+
+    /**
+    * divide a 3 * half limb number by a 2 * half limb number, same requirements as
+    * _divideTwoByOne
+    * @param num the dividend
+    * @param divisor the divisor
+    * @param half half the length of the divisor
+    * @param quotient output, num / divisor
+    * @param remainder output, num % divisor
+    */
+    static void _divideThreeByTwo(const big_integer &num, const big_integer &divisor, size_t half,
+                                  big_integer &quotient, big_integer &remainder);
+
+    /**
+    * schoolbook long division (knuth's algorithm D), one quotient limb per step.
+    * divisor must be normalized with at least 2 limbs and len >= divLen.
+    * @param quotient output of len - divLen + 1 limbs
+    * @param remainder output of divLen limbs
+    * @param num the dividend
+    * @param len length of num
+    * @param divisor the divisor
+    * @param divLen length of divisor
+    */
+    static void _divideKnuth(limb_t *quotient, limb_t *remainder, const limb_t *num, size_t len,
+                             const limb_t *divisor, size_t divLen);
+
+    /**
+    * shared body of powmod and powmod_constant_time
+    * @param base the base
+    * @param exponent the exponent
+    * @param modulus the modulus
+    * @param constantTime true to hide the bits of the exponent
+    * @return base^exponent mod |modulus|
+    */
+    static big_integer _powmod(const big_integer &base, const big_integer &exponent,
+                               const big_integer &modulus, bool constantTime);
+
+    /**
+    * handle the exponentiations that need no multiplication
+    * @param exponent the exponent
+    * @param modulus the magnitude of the modulus
+    * @param result output, set when the power is trivial
+    * @return true if result holds the power
+    */
+    static bool _powmodTrivial(const big_integer &exponent, const limb_vector &modulus,
+                               big_integer &result);
+
+    /**
+    * compute the constants of montgomery arithmetic modulo an odd modulus
+    * @param modulus an odd modulus
+    * @param rSquared output, 2^(2 * 64 * len) mod modulus padded to the length of modulus
+    * @return the constant from _montgomeryInverse
+    */
+    static limb_t _montgomeryConstants(const limb_vector &modulus, limb_vector &rSquared);
+
+    /**
+    * modular exponentiation in montgomery form, all intermediate values live in one buffer
+    * @param result output, the normalized power
+    * @param base the base, already reduced below modulus
+    * @param exponent the exponent, not 0
+    * @param modulus an odd modulus
+    * @param rSquared the constant from _montgomeryConstants
+    * @param inverse the constant from _montgomeryConstants
+    * @param constantTime true for a fixed window with masked table reads
+    */
+    static void _powmodMontgomery(limb_vector &result, const limb_vector &base,
+                                  const limb_vector &exponent, const limb_vector &modulus,
+                                  const limb_vector &rSquared, limb_t inverse,
+                                  bool constantTime);
+
+    /**
+    * modular exponentiation reducing by division, used for even moduli
+    * @param result output, the normalized power
+    * @param base the base, already reduced below modulus
+    * @param exponent the exponent, not 0
+    * @param modulus the modulus
+    */
+    static void _powmodDivision(limb_vector &result, const limb_vector &base,
+                                const limb_vector &exponent, const limb_vector &modulus);
+
+    /**
+    * the window width of the exponentiation, wider windows pay off for longer exponents
+    * @param bits length of the exponent in bits
+    * @return the number of exponent bits handled per table multiplication
     */
-    static big_integer _multiplication(const big_integer &num1, const big_integer &num2);
+    static size_t _windowBits(size_t bits);
+
+    /**
+    * read up to 64 bits of a number, bits past its end are 0
+    * @param num a number
+    * @param len length of num
+    * @param start index of the lowest bit
+    * @param count number of bits, at most 64
+    * @return the bits [start, start + count) of num
+    */
+    static limb_t _extractBits(const limb_t *num, size_t len, size_t start, size_t count);
+
+    /**
+    * @param modulus0 the lowest limb of an odd modulus
+    * @return -modulus^-1 mod 2^64, the constant of montgomery reduction
+    */
+    static limb_t _montgomeryInverse(limb_t modulus0);
+
+    /**
+    * montgomery reduction, result = product / 2^(64 * len) mod modulus, without branches
+    * on the data. product must be below modulus * 2^(64 * len).
+    * @param result output of len limbs, below modulus
+    * @param product 2 * len limbs, destroyed
+    * @param modulus an odd modulus
+    * @param len length of modulus
+    * @param inverse the constant from _montgomeryInverse
+    */
+    static void _montgomeryReduce(limb_t *result, limb_t *product, const limb_t *modulus,
+                                  size_t len, limb_t inverse);
+
+    /**
+    * montgomery multiplication, result = num1 * num2 / 2^(64 * len) mod modulus.
+    * result may alias num1 or num2.
+    * @param result output of len limbs, below modulus
+    * @param num1 len limbs below modulus
+    * @param num2 len limbs below modulus
+    * @param modulus an odd modulus
+    * @param len length of modulus
+    * @param inverse the constant from _montgomeryInverse
+    * @param scratch 2 * len + _multiplyScratchSize(len) limbs of scratch space
+    * @param constantTime true to use the schoolbook product, whose timing ignores the values
+    */
+    static void _montgomeryMultiply(limb_t *result, const limb_t *num1, const limb_t *num2,
+                                    const limb_t *modulus, size_t len, limb_t inverse,
+                                    limb_t *scratch, bool constantTime);
+
+    /**
+    * @param len length of both operands
+    * @return the limbs of scratch space _multiplyInScratch needs for them, enough for any
+    * karatsuba threshold
+    */
+    static size_t _multiplyScratchSize(size_t len);
+
+    /**
+    * karatsuba multiplication of two numbers of the same length that keeps its temporaries
+    * in caller scratch instead of allocating, for the fixed size products of modular
+    * reduction. squares when num1 and num2 are the same limbs. the operands need not be
+    * normalized.
+    * @param result output of 2 * len limbs, must not alias the operands or scratch
+    * @param num1 a number
+    * @param num2 a number
+    * @param len length of both numbers
+    * @param scratch _multiplyScratchSize(len) limbs of scratch space
+    */
+    static void _multiplyInScratch(limb_t *result, const limb_t *num1, const limb_t *num2,
+                                   size_t len, limb_t *scratch);
+
+    /**
+    * reduce a number to its non negative residue
+    * @param num a number of any sign
+    * @param modulus a non zero magnitude
+    * @param result output, num mod modulus in [0, modulus)
+    */
+    static void _reduceNonNegative(const big_integer &num, const limb_vector &modulus,
+                                   limb_vector &result);
+
+    /**
+    * run euclid's algorithm on two magnitudes until num2 is 0.
+    * every step (num1, num2) -> (m00 * num1 + m01 * num2, m10 * num1 + m11 * num2) is also
+    * applied to the tracked pairs (u, v), so tracking (1, 0) gives the bezout coefficient
+    * of the original num1.
+    * @param num1 a magnitude, not below num2, ends as the gcd
+    * @param num2 a magnitude, ends as 0
+    * @param tracked 2 * count pointers, pair i is (tracked[2i], tracked[2i + 1])
+    * @param count number of tracked pairs
+    */
+    static void _gcdReduce(big_integer &num1, big_integer &num2, big_integer **tracked,
+                           size_t count);
+
+    /**
+    * half gcd, reduce two magnitudes of n limbs by euclid steps until num2 has about n / 2
+    * limbs, the steps are applied to the tracked pairs like in _gcdReduce.
+    * the numbers are first reduced through a recursive call on their leading half, one
+    * division step follows, and a second recursive call on the leading part of the result
+    * takes them to n / 2 limbs.
+    * @param num1 a magnitude, not below num2
+    * @param num2 a magnitude
+    * @param tracked 2 * count pointers to the tracked pairs
+    * @param count number of tracked pairs
+    */
+    static void _halfGcd(big_integer &num1, big_integer &num2, big_integer **tracked,
+                         size_t count);
+
+    /**
+    * reduce the leading parts num1 / 2^(64 * shift) and num2 / 2^(64 * shift) by _halfGcd and
+    * apply the steps taken to the whole numbers and to the tracked pairs
+    * @param num1 a magnitude, not below num2
+    * @param num2 a magnitude
+    * @param shift number of low limbs left out
+    * @param tracked 2 * count pointers to the tracked pairs
+    * @param count number of tracked pairs
+    */
+    static void _halfGcdLeading(big_integer &num1, big_integer &num2, size_t shift,
+                                big_integer **tracked, size_t count);
+
+    /**
+    * one step of lehmer's algorithm: the quotients of the leading 62 bits are collected into a
+    * matrix of single words while they are certainly those of the whole numbers, then the
+    * matrix is applied at once. falls back to a division step when no quotient is certain.
+    * @param num1 a magnitude, not below num2
+    * @param num2 a non zero magnitude
+    * @param scratch two vectors that are swapped with the limbs of num1 and num2
+    * @param tracked 2 * count pointers to the tracked pairs
+    * @param count number of tracked pairs
+    */
+    static void _lehmerStep(big_integer &num1, big_integer &num2, limb_vector *scratch,
+                            big_integer **tracked, size_t count);
+
+    /**
+    * one step of euclid's algorithm, (num1, num2) -> (num2, num1 mod num2)
+    * @param num1 a magnitude, not below num2
+    * @param num2 a non zero magnitude
+    * @param tracked 2 * count pointers to the tracked pairs
+    * @param count number of tracked pairs
+    */
+    static void _gcdDivisionStep(big_integer &num1, big_integer &num2, big_integer **tracked,
+                                 size_t count);
+
+    /**
+    * apply a 2x2 matrix to the tracked pairs, (u, v) -> (m00 * u + m01 * v, m10 * u + m11 * v)
+    * @param tracked 2 * count pointers to the tracked pairs
+    * @param count number of tracked pairs
+    * @param matrix the entries m00, m01, m10, m11
+    */
+    static void _trackTransform(big_integer **tracked, size_t count, const big_integer *matrix);
+
+    /**
+    * result = coefficient1 * num1 + coefficient2 * num2 for a combination known not to be
+    * negative
+    * @param result output, normalized
+    * @param num1 a magnitude
+    * @param coefficient1 its coefficient
+    * @param num2 a magnitude
+    * @param coefficient2 its coefficient
+    */
+    static void _combineLimbs(limb_vector &result, const limb_vector &num1,
+                              std::int64_t coefficient1, const limb_vector &num2,
+                              std::int64_t coefficient2);
+
+    /**
+    * @param value a word
+    * @return value as a big_integer
+    */
+    static big_integer _fromWord(std::int64_t value);
+
+    /**
+    * the k-th root of a magnitude, computed from the root of its leading bits
+    * @param num a magnitude
+    * @param k the degree of the root, not 0
+    * @return floor(num^(1/k))
+    */
+    static big_integer _rootMagnitude(const big_integer &num, unsigned int k);
+
+    /**
+    * one newton step towards the k-th root, from any x > 0 the result is at least the root
+    * @param num a magnitude
+    * @param x the current approximation, not 0
+    * @param k the degree of the root
+    * @return floor(((k - 1) * x + num / x^(k - 1)) / k)
+    */
+    static big_integer _rootNewtonStep(const big_integer &num, const big_integer &x,
+                                       unsigned int k);
+
+    /**
+    * @param base the base
+    * @param exponent the exponent
+    * @return base^exponent, by repeated squaring
+    */
+    static big_integer _power(const big_integer &base, unsigned int exponent);
 
     /**
     * init data members
@@ -230,15 +1613,12 @@ private:
     void _initDataMembers();
 
     /**
-    * set larger and smaller (length of number)
-    * @param num1 big_integer
-    * @param num2 big_integer
-    * @param larger big_integer
-    * @param smaller big_integer
+    * forget the cached hash, called whenever the value changes
     */
-    static void
-    _setLargerAndSmaller(const big_integer &num1, const big_integer &num2, big_integer &larger,
-                        big_integer &smaller);
+    void _resetHash()
+    {
+        _hash.store(0, std::memory_order_relaxed);
+    }
 
     /**
     * if num is 0 make it positive
@@ -248,5 +1628,25 @@ private:
     big_integer &_makeZeroPositive(big_integer &result) const;
 };
 
+namespace std
+{
+    /**
+     * lets big_integer be used as a key of unordered containers
+     * @struct hash<big_integer>
+     */
+    template<>
+    struct hash<big_integer>
+    {
+        /**
+         * @param num a big integer
+         * @return the hash of num
+         */
+        size_t operator()(const big_integer &num) const
+        {
+            return num.hash();
+        }
+    };
+}
+
 
 #endif //EX1_BIG_INTEGER_H
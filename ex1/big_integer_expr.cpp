@@ -0,0 +1,189 @@
+#include <utility>
+#include "big_integer_expr.h"
+
+typedef big_integer::limb_t limb_t;
+
+/* number of bits in a limb */
+const int LIMB_BITS = 64;
+
+/**
+ * constructor, a zero sum
+ * @param limbBound an upper bound on the magnitude of every partial sum, in limbs
+ */
+big_integer_accumulator::big_integer_accumulator(size_t limbBound) : _sum(limbBound + 1),
+                                                                     _isEmpty(true),
+                                                                     _isNegated(false)
+{
+}
+
+/**
+ * add (or substract) a number
+ * @param num the number
+ * @param negate true to substract num
+ */
+void big_integer_accumulator::add(const big_integer &num, bool negate)
+{
+    _addMagnitude(num._limbs.data(), num._limbs.size(), negate != !num._isPositive);
+}
+
+/**
+ * add (or substract) the product of a few numbers
+ * @param factors pointers to the factors
+ * @param count number of factors, at least 1
+ * @param negate true to substract the product
+ */
+void big_integer_accumulator::add_product(const big_integer *const *factors, size_t count,
+                                          bool negate)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (factors[i]->_limbs.empty())
+        {
+            return;
+        }
+        negate = negate != !factors[i]->_isPositive;
+    }
+    const limb_t *num1 = factors[0]->_limbs.data();
+    size_t len1 = factors[0]->_limbs.size();
+
+    // all factors but the last are multiplied into _product
+    for (size_t i = 1; i + 1 < count; i++)
+    {
+        const limb_vector &factor = factors[i]->_limbs;
+        _scratch.resize(len1 + factor.size());
+        big_integer::_multiply(_scratch.data(), num1, len1, factor.data(), factor.size());
+        len1 = big_integer::_trimmedLength(_scratch.data(), _scratch.size());
+        std::swap(_product, _scratch);
+        num1 = _product.data();
+    }
+
+    if (count == 1)
+    {
+        _addMagnitude(num1, len1, negate);
+        return;
+    }
+    const limb_t *num2 = factors[count - 1]->_limbs.data();
+    size_t len2 = factors[count - 1]->_limbs.size();
+    if (len1 < len2)
+    {
+        std::swap(num1, num2);
+        std::swap(len1, len2);
+    }
+    if (len2 < big_integer::get_multiplication_thresholds().karatsuba)
+    {
+        _addProductRows(num1, len1, num2, len2, negate);
+    }
+    else if (_isEmpty)
+    {
+        // the sum is still zero and has room for the product, keep the sign aside
+        big_integer::_multiply(_sum.data(), num1, len1, num2, len2);
+        _isNegated = negate;
+        _isEmpty = false;
+    }
+    else
+    {
+        _scratch.resize(len1 + len2);
+        big_integer::_multiply(_scratch.data(), num1, len1, num2, len2);
+        _addMagnitude(_scratch.data(), big_integer::_trimmedLength(_scratch.data(), len1 + len2),
+                      negate);
+    }
+}
+
+/**
+ * keep a temporary alive until the accumulator dies
+ * @param value the temporary
+ * @return a reference to the stored value
+ */
+const big_integer &big_integer_accumulator::hold(big_integer &&value)
+{
+    _held.push_front(std::move(value));
+    return _held.front();
+}
+
+/**
+ * move the sum into result, the accumulator is left empty
+ * @param result the destination
+ */
+void big_integer_accumulator::store(big_integer &result)
+{
+    // the top limb is only there for the sign, a set top bit means a negative sum
+    bool negative = (_sum.back() >> (LIMB_BITS - 1)) != 0;
+    if (negative)
+    {
+        limb_t carry = 1;
+        for (limb_t &limb : _sum)
+        {
+            carry = __builtin_add_overflow(~limb, carry, &limb);
+        }
+    }
+    big_integer::_normalize(_sum);
+    result._limbs = std::move(_sum);
+    result._isPositive = negative == _isNegated || result._limbs.empty();
+    result._resetHash();
+    _sum.clear();
+    _isEmpty = true;
+    _isNegated = false;
+}
+
+/**
+ * @param num a big integer
+ * @return the number of limbs of num
+ */
+size_t big_integer_accumulator::limb_count(const big_integer &num)
+{
+    return num._limbs.size();
+}
+
+/**
+ * add (or substract) a magnitude
+ * @param num the magnitude
+ * @param len length of num
+ * @param negate true to substract num
+ */
+void big_integer_accumulator::_addMagnitude(const limb_t *num, size_t len, bool negate)
+{
+    negate = negate != _isNegated;
+    _isEmpty = false;
+    limb_t *sum = _sum.data();
+    limb_t carry = negate ? big_integer::_substract(sum, sum, len, num, len)
+                          : big_integer::_add(sum, sum, len, num, len);
+    _propagate(len, carry, negate);
+}
+
+/**
+ * add (or substract) the product of two magnitudes directly into the sum, one row at a time
+ * @param num1 the longer number
+ * @param len1 length of num1
+ * @param num2 the shorter number
+ * @param len2 length of num2
+ * @param negate true to substract the product
+ */
+void big_integer_accumulator::_addProductRows(const limb_t *num1, size_t len1, const limb_t *num2,
+                                              size_t len2, bool negate)
+{
+    negate = negate != _isNegated;
+    _isEmpty = false;
+    limb_t *sum = _sum.data();
+    for (size_t i = 0; i < len2; i++)
+    {
+        limb_t carry = negate ? big_integer::_substractMultiplyRow(sum + i, num1, len1, num2[i])
+                              : big_integer::_addMultiplyRow(sum + i, num1, len1, num2[i]);
+        _propagate(i + len1, carry, negate);
+    }
+}
+
+/**
+ * propagate a carry (or borrow) from the given limb of the sum upwards
+ * @param index the limb to start at
+ * @param value the carry
+ * @param negate true to propagate a borrow
+ */
+void big_integer_accumulator::_propagate(size_t index, limb_t value, bool negate)
+{
+    // anything carried out of the top limb is dropped, the sum is kept modulo 2^(64 * size)
+    for (size_t i = index; value != 0 && i < _sum.size(); i++)
+    {
+        value = negate ? __builtin_sub_overflow(_sum[i], value, &_sum[i])
+                       : __builtin_add_overflow(_sum[i], value, &_sum[i]);
+    }
+}
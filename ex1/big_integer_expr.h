@@ -0,0 +1,382 @@
+#ifndef EX1_BIG_INTEGER_EXPR_H
+#define EX1_BIG_INTEGER_EXPR_H
+
+#include <cstddef>
+#include <forward_list>
+#include "big_integer.h"
+
+/**
+ * a signed sum of big integers and products kept in a single fixed width two's complement
+ * buffer. the buffer is sized once, products are multiplied straight into it, and the
+ * result is stored in the destination with one final pass.
+ * this is the engine behind the lazy expressions below, it is not meant to be used directly.
+ * @author Idan Yamin
+ * @class big_integer_accumulator
+ */
+class big_integer_accumulator
+{
+public:
+    /**
+     * constructor, a zero sum
+     * @param limbBound an upper bound on the magnitude of every partial sum, in limbs
+     */
+    explicit big_integer_accumulator(size_t limbBound);
+
+    /**
+     * add (or substract) a number
+     * @param num the number
+     * @param negate true to substract num
+     */
+    void add(const big_integer &num, bool negate);
+
+    /**
+     * add (or substract) the product of a few numbers
+     * @param factors pointers to the factors
+     * @param count number of factors, at least 1
+     * @param negate true to substract the product
+     */
+    void add_product(const big_integer *const *factors, size_t count, bool negate);
+
+    /**
+     * keep a temporary alive until the accumulator dies
+     * @param value the temporary
+     * @return a reference to the stored value
+     */
+    const big_integer &hold(big_integer &&value);
+
+    /**
+     * move the sum into result, the accumulator is left empty
+     * @param result the destination
+     */
+    void store(big_integer &result);
+
+    /**
+     * @param num a big integer
+     * @return the number of limbs of num
+     */
+    static size_t limb_count(const big_integer &num);
+
+private:
+    /* the sum, in two's complement over a fixed number of limbs */
+    limb_vector _sum;
+
+    /* buffers for products of more than two factors */
+    limb_vector _product, _scratch;
+
+    /* true while nothing was added, the first product is then written straight into _sum */
+    bool _isEmpty;
+
+    /* true if _sum holds the negated value */
+    bool _isNegated;
+
+    /* temporaries referenced by the expression, a list keeps them in place */
+    std::forward_list<big_integer> _held;
+
+    /**
+    * add (or substract) a magnitude
+    * @param num the magnitude
+    * @param len length of num
+    * @param negate true to substract num
+    */
+    void _addMagnitude(const big_integer::limb_t *num, size_t len, bool negate);
+
+    /**
+    * add (or substract) the product of two magnitudes directly into the sum, one row at a time
+    * @param num1 the longer number
+    * @param len1 length of num1
+    * @param num2 the shorter number
+    * @param len2 length of num2
+    * @param negate true to substract the product
+    */
+    void _addProductRows(const big_integer::limb_t *num1, size_t len1,
+                         const big_integer::limb_t *num2, size_t len2, bool negate);
+
+    /**
+    * propagate a carry (or borrow) from the given limb of the sum upwards
+    * @param index the limb to start at
+    * @param value the carry
+    * @param negate true to propagate a borrow
+    */
+    void _propagate(size_t index, big_integer::limb_t value, bool negate);
+};
+
+/**
+ * base of every lazy expression node. a node captures its operands by reference and
+ * computes nothing until it is converted to a big_integer or passed to evaluate_into, so
+ * an expression must be evaluated within the full expression that built it.
+ * sums and differences are flattened into a list of signed terms, and products inside a
+ * term are multiplied straight into the result buffer. a sum used as a factor, like the
+ * (a + b) in (a + b) * c, is evaluated to a temporary first.
+ * @author Idan Yamin
+ * @class lazy_expression
+ * @tparam Derived the node type
+ */
+template<class Derived>
+class lazy_expression
+{
+public:
+    /**
+     * @return the node as its real type
+     */
+    const Derived &derived() const
+    {
+        return static_cast<const Derived &>(*this);
+    }
+
+    /**
+     * evaluate the expression
+     * @return the value of the expression
+     */
+    operator big_integer() const;
+};
+
+/**
+ * a big integer operand of a lazy expression
+ * @class lazy_leaf
+ */
+class lazy_leaf : public lazy_expression<lazy_leaf>
+{
+public:
+    /* number of factors this node contributes to a product */
+    static const size_t FACTORS = 1;
+
+    /**
+     * constructor
+     * @param value the operand, must outlive the expression
+     */
+    explicit lazy_leaf(const big_integer &value) : _value(value)
+    {};
+
+    /**
+     * @return an upper bound on the length of the value, in limbs
+     */
+    size_t limb_bound() const
+    {
+        return big_integer_accumulator::limb_count(_value);
+    }
+
+    /**
+     * add the value to an accumulator
+     * @param acc the accumulator
+     * @param negate true to substract the value
+     */
+    void accumulate(big_integer_accumulator &acc, bool negate) const
+    {
+        acc.add(_value, negate);
+    }
+
+    /**
+     * write the factors of this node
+     * @param factors where to write, must have room for FACTORS pointers
+     * @param acc the accumulator that keeps temporaries alive
+     * @return the position after the last factor written
+     */
+    const big_integer **collect(const big_integer **factors, big_integer_accumulator &acc) const
+    {
+        (void) acc;
+        *factors = &_value;
+        return factors + 1;
+    }
+
+private:
+    /* the operand */
+    const big_integer &_value;
+};
+
+/**
+ * the sum (or difference) of two lazy expressions
+ * @class lazy_sum
+ * @tparam Left the left operand node
+ * @tparam Right the right operand node
+ * @tparam Negate true for left - right
+ */
+template<class Left, class Right, bool Negate>
+class lazy_sum : public lazy_expression<lazy_sum<Left, Right, Negate>>
+{
+public:
+    /* a sum is evaluated to a single factor when it is multiplied */
+    static const size_t FACTORS = 1;
+
+    /**
+     * constructor
+     * @param left the left operand
+     * @param right the right operand
+     */
+    lazy_sum(const Left &left, const Right &right) : _left(left), _right(right)
+    {};
+
+    /**
+     * @return an upper bound on the length of the value, in limbs
+     */
+    size_t limb_bound() const;
+
+    /**
+     * add the value to an accumulator, term by term
+     * @param acc the accumulator
+     * @param negate true to substract the value
+     */
+    void accumulate(big_integer_accumulator &acc, bool negate) const;
+
+    /**
+     * evaluate the sum to a temporary held by acc and write it as a factor
+     * @param factors where to write, must have room for FACTORS pointers
+     * @param acc the accumulator that keeps temporaries alive
+     * @return the position after the last factor written
+     */
+    const big_integer **collect(const big_integer **factors, big_integer_accumulator &acc) const;
+
+private:
+    /* the operands */
+    Left _left;
+    Right _right;
+};
+
+/**
+ * the product of two lazy expressions
+ * @class lazy_product
+ * @tparam Left the left operand node
+ * @tparam Right the right operand node
+ */
+template<class Left, class Right>
+class lazy_product : public lazy_expression<lazy_product<Left, Right>>
+{
+public:
+    /* nested products are flattened into one list of factors */
+    static const size_t FACTORS = Left::FACTORS + Right::FACTORS;
+
+    /**
+     * constructor
+     * @param left the left operand
+     * @param right the right operand
+     */
+    lazy_product(const Left &left, const Right &right) : _left(left), _right(right)
+    {};
+
+    /**
+     * @return an upper bound on the length of the value, in limbs
+     */
+    size_t limb_bound() const;
+
+    /**
+     * multiply the factors into an accumulator
+     * @param acc the accumulator
+     * @param negate true to substract the value
+     */
+    void accumulate(big_integer_accumulator &acc, bool negate) const;
+
+    /**
+     * write the factors of both operands
+     * @param factors where to write, must have room for FACTORS pointers
+     * @param acc the accumulator that keeps temporaries alive
+     * @return the position after the last factor written
+     */
+    const big_integer **collect(const big_integer **factors, big_integer_accumulator &acc) const;
+
+private:
+    /* the operands */
+    Left _left;
+    Right _right;
+};
+
+/**
+ * start a lazy expression
+ * @param num an operand, must outlive the expression
+ * @return a lazy operand
+ */
+inline lazy_leaf lazy(const big_integer &num)
+{
+    return lazy_leaf(num);
+}
+
+/**
+ * evaluate an expression into dest, which may appear in the expression
+ * @param dest the destination
+ * @param expr the expression
+ */
+template<class Expr>
+void evaluate_into(big_integer &dest, const lazy_expression<Expr> &expr);
+
+/**
+ * @param num1 an expression
+ * @param num2 an expression
+ * @return the lazy sum
+ */
+template<class Left, class Right>
+lazy_sum<Left, Right, false> operator+(const lazy_expression<Left> &num1,
+                                       const lazy_expression<Right> &num2);
+
+/**
+ * @param num1 an expression
+ * @param num2 a big integer
+ * @return the lazy sum
+ */
+template<class Left>
+lazy_sum<Left, lazy_leaf, false> operator+(const lazy_expression<Left> &num1,
+                                           const big_integer &num2);
+
+/**
+ * @param num1 a big integer
+ * @param num2 an expression
+ * @return the lazy sum
+ */
+template<class Right>
+lazy_sum<lazy_leaf, Right, false> operator+(const big_integer &num1,
+                                            const lazy_expression<Right> &num2);
+
+/**
+ * @param num1 an expression
+ * @param num2 an expression
+ * @return the lazy difference
+ */
+template<class Left, class Right>
+lazy_sum<Left, Right, true> operator-(const lazy_expression<Left> &num1,
+                                      const lazy_expression<Right> &num2);
+
+/**
+ * @param num1 an expression
+ * @param num2 a big integer
+ * @return the lazy difference
+ */
+template<class Left>
+lazy_sum<Left, lazy_leaf, true> operator-(const lazy_expression<Left> &num1,
+                                          const big_integer &num2);
+
+/**
+ * @param num1 a big integer
+ * @param num2 an expression
+ * @return the lazy difference
+ */
+template<class Right>
+lazy_sum<lazy_leaf, Right, true> operator-(const big_integer &num1,
+                                           const lazy_expression<Right> &num2);
+
+/**
+ * @param num1 an expression
+ * @param num2 an expression
+ * @return the lazy product
+ */
+template<class Left, class Right>
+lazy_product<Left, Right> operator*(const lazy_expression<Left> &num1,
+                                    const lazy_expression<Right> &num2);
+
+/**
+ * @param num1 an expression
+ * @param num2 a big integer
+ * @return the lazy product
+ */
+template<class Left>
+lazy_product<Left, lazy_leaf> operator*(const lazy_expression<Left> &num1,
+                                        const big_integer &num2);
+
+/**
+ * @param num1 a big integer
+ * @param num2 an expression
+ * @return the lazy product
+ */
+template<class Right>
+lazy_product<lazy_leaf, Right> operator*(const big_integer &num1,
+                                         const lazy_expression<Right> &num2);
+
+#include "big_integer_expr.hpp"
+
+#endif //EX1_BIG_INTEGER_EXPR_H
@@ -0,0 +1,210 @@
+#ifndef EX1_BIG_INTEGER_EXPR_HPP
+#define EX1_BIG_INTEGER_EXPR_HPP
+
+#include <algorithm>
+#include "big_integer_expr.h"
+
+/**
+ * evaluate the expression
+ * @return the value of the expression
+ */
+template<class Derived>
+lazy_expression<Derived>::operator big_integer() const
+{
+    big_integer result;
+    evaluate_into(result, *this);
+    return result;
+}
+
+/**
+ * @return an upper bound on the length of the value, in limbs
+ */
+template<class Left, class Right, bool Negate>
+size_t lazy_sum<Left, Right, Negate>::limb_bound() const
+{
+    return std::max(_left.limb_bound(), _right.limb_bound()) + 1;
+}
+
+/**
+ * add the value to an accumulator, term by term
+ * @param acc the accumulator
+ * @param negate true to substract the value
+ */
+template<class Left, class Right, bool Negate>
+void lazy_sum<Left, Right, Negate>::accumulate(big_integer_accumulator &acc, bool negate) const
+{
+    _left.accumulate(acc, negate);
+    _right.accumulate(acc, negate != Negate);
+}
+
+/**
+ * evaluate the sum to a temporary held by acc and write it as a factor
+ * @param factors where to write, must have room for FACTORS pointers
+ * @param acc the accumulator that keeps temporaries alive
+ * @return the position after the last factor written
+ */
+template<class Left, class Right, bool Negate>
+const big_integer **lazy_sum<Left, Right, Negate>::collect(const big_integer **factors,
+                                                           big_integer_accumulator &acc) const
+{
+    *factors = &acc.hold(big_integer(*this));
+    return factors + 1;
+}
+
+/**
+ * @return an upper bound on the length of the value, in limbs
+ */
+template<class Left, class Right>
+size_t lazy_product<Left, Right>::limb_bound() const
+{
+    return _left.limb_bound() + _right.limb_bound();
+}
+
+/**
+ * multiply the factors into an accumulator
+ * @param acc the accumulator
+ * @param negate true to substract the value
+ */
+template<class Left, class Right>
+void lazy_product<Left, Right>::accumulate(big_integer_accumulator &acc, bool negate) const
+{
+    const big_integer *factors[FACTORS];
+    collect(factors, acc);
+    acc.add_product(factors, FACTORS, negate);
+}
+
+/**
+ * write the factors of both operands
+ * @param factors where to write, must have room for FACTORS pointers
+ * @param acc the accumulator that keeps temporaries alive
+ * @return the position after the last factor written
+ */
+template<class Left, class Right>
+const big_integer **lazy_product<Left, Right>::collect(const big_integer **factors,
+                                                       big_integer_accumulator &acc) const
+{
+    return _right.collect(_left.collect(factors, acc), acc);
+}
+
+/**
+ * evaluate an expression into dest, which may appear in the expression
+ * @param dest the destination
+ * @param expr the expression
+ */
+template<class Expr>
+void evaluate_into(big_integer &dest, const lazy_expression<Expr> &expr)
+{
+    big_integer_accumulator acc(expr.derived().limb_bound());
+    expr.derived().accumulate(acc, false);
+    acc.store(dest);
+}
+
+/**
+ * @param num1 an expression
+ * @param num2 an expression
+ * @return the lazy sum
+ */
+template<class Left, class Right>
+lazy_sum<Left, Right, false> operator+(const lazy_expression<Left> &num1,
+                                       const lazy_expression<Right> &num2)
+{
+    return lazy_sum<Left, Right, false>(num1.derived(), num2.derived());
+}
+
+/**
+ * @param num1 an expression
+ * @param num2 a big integer
+ * @return the lazy sum
+ */
+template<class Left>
+lazy_sum<Left, lazy_leaf, false> operator+(const lazy_expression<Left> &num1,
+                                           const big_integer &num2)
+{
+    return lazy_sum<Left, lazy_leaf, false>(num1.derived(), lazy_leaf(num2));
+}
+
+/**
+ * @param num1 a big integer
+ * @param num2 an expression
+ * @return the lazy sum
+ */
+template<class Right>
+lazy_sum<lazy_leaf, Right, false> operator+(const big_integer &num1,
+                                            const lazy_expression<Right> &num2)
+{
+    return lazy_sum<lazy_leaf, Right, false>(lazy_leaf(num1), num2.derived());
+}
+
+/**
+ * @param num1 an expression
+ * @param num2 an expression
+ * @return the lazy difference
+ */
+template<class Left, class Right>
+lazy_sum<Left, Right, true> operator-(const lazy_expression<Left> &num1,
+                                      const lazy_expression<Right> &num2)
+{
+    return lazy_sum<Left, Right, true>(num1.derived(), num2.derived());
+}
+
+/**
+ * @param num1 an expression
+ * @param num2 a big integer
+ * @return the lazy difference
+ */
+template<class Left>
+lazy_sum<Left, lazy_leaf, true> operator-(const lazy_expression<Left> &num1,
+                                          const big_integer &num2)
+{
+    return lazy_sum<Left, lazy_leaf, true>(num1.derived(), lazy_leaf(num2));
+}
+
+/**
+ * @param num1 a big integer
+ * @param num2 an expression
+ * @return the lazy difference
+ */
+template<class Right>
+lazy_sum<lazy_leaf, Right, true> operator-(const big_integer &num1,
+                                           const lazy_expression<Right> &num2)
+{
+    return lazy_sum<lazy_leaf, Right, true>(lazy_leaf(num1), num2.derived());
+}
+
+/**
+ * @param num1 an expression
+ * @param num2 an expression
+ * @return the lazy product
+ */
+template<class Left, class Right>
+lazy_product<Left, Right> operator*(const lazy_expression<Left> &num1,
+                                    const lazy_expression<Right> &num2)
+{
+    return lazy_product<Left, Right>(num1.derived(), num2.derived());
+}
+
+/**
+ * @param num1 an expression
+ * @param num2 a big integer
+ * @return the lazy product
+ */
+template<class Left>
+lazy_product<Left, lazy_leaf> operator*(const lazy_expression<Left> &num1,
+                                        const big_integer &num2)
+{
+    return lazy_product<Left, lazy_leaf>(num1.derived(), lazy_leaf(num2));
+}
+
+/**
+ * @param num1 a big integer
+ * @param num2 an expression
+ * @return the lazy product
+ */
+template<class Right>
+lazy_product<lazy_leaf, Right> operator*(const big_integer &num1,
+                                         const lazy_expression<Right> &num2)
+{
+    return lazy_product<lazy_leaf, Right>(lazy_leaf(num1), num2.derived());
+}
+
+#endif //EX1_BIG_INTEGER_EXPR_HPP
@@ -0,0 +1,149 @@
+#include "big_integer_view.h"
+
+/**
+ * open a view over an encoding written by big_integer::serialize
+ * @param buffer the encoding, at any alignment
+ * @param size number of bytes available in buffer, it may hold more after the encoding
+ * @param view output, a view of 0 if the encoding is invalid
+ * @return the number of bytes of the encoding, where the next one may start. 0 if the
+ * encoding is truncated, has an unknown version or is not normalized
+ */
+size_t big_integer_view::open(const unsigned char *buffer, size_t size, big_integer_view &view)
+{
+    size_t count = 0;
+    bool negative = false;
+    size_t header = big_integer::_readSerialHeader(buffer, size, count, negative);
+    if (header == 0)
+    {
+        view = big_integer_view();
+        return 0;
+    }
+    view._limbs = buffer + header;
+    view._size = count;
+    view._isNegative = negative;
+    return header + count * sizeof(limb_t);
+}
+
+/**
+ * copy the number out of the buffer
+ * @return the value as a big_integer
+ */
+big_integer_view::operator big_integer() const
+{
+    big_integer num;
+    num._limbs.resize(_size);
+    big_integer::_readLimbs(num._limbs.data(), _limbs, _size);
+    num._isPositive = !_isNegative;
+    return num;
+}
+
+/**
+ * compare to a number given by its sign and limbs
+ * @param negative the sign of the other number
+ * @param size number of limbs of the other number
+ * @param limbOf the limb of the other number at an index
+ * @return -1 if this is smaller, 0 if they are equal, 1 if this is larger
+ */
+template<class LimbOf>
+int big_integer_view::_compare(bool negative, size_t size, const LimbOf &limbOf) const
+{
+    if (_isNegative != negative)
+    {
+        return _isNegative ? -1 : 1;
+    }
+    // the magnitudes order the other way for negative numbers
+    int sign = _isNegative ? -1 : 1;
+    if (_size != size)
+    {
+        return _size < size ? -sign : sign;
+    }
+    for (size_t i = _size; i > 0; i--)
+    {
+        limb_t mine = limb(i - 1), other = limbOf(i - 1);
+        if (mine != other)
+        {
+            return mine < other ? -sign : sign;
+        }
+    }
+    return 0;
+}
+
+/**
+ * three way comparison, scans the limbs from the most significant end
+ * @param other the number to compare to
+ * @return -1 if this < other, 0 if they are equal, 1 if this > other
+ */
+int big_integer_view::compare(const big_integer_view &other) const
+{
+    return _compare(other._isNegative, other._size, [&other](size_t i)
+    {
+        return other.limb(i);
+    });
+}
+
+/**
+ * three way comparison without copying the view
+ * @param num the number to compare to
+ * @return -1 if this < num, 0 if they are equal, 1 if this > num
+ */
+int big_integer_view::compare(const big_integer &num) const
+{
+    return _compare(!num._isPositive, num._limbs.size(), [&num](size_t i)
+    {
+        return num._limbs[i];
+    });
+}
+
+/**
+ * @param other the number to compare to
+ * @return true if this == other
+ */
+bool big_integer_view::operator==(const big_integer_view &other) const
+{
+    return compare(other) == 0;
+}
+
+/**
+ * @param other the number to compare to
+ * @return true if this != other
+ */
+bool big_integer_view::operator!=(const big_integer_view &other) const
+{
+    return compare(other) != 0;
+}
+
+/**
+ * @param other the number to compare to
+ * @return true if this > other
+ */
+bool big_integer_view::operator>(const big_integer_view &other) const
+{
+    return compare(other) > 0;
+}
+
+/**
+ * @param other the number to compare to
+ * @return true if this < other
+ */
+bool big_integer_view::operator<(const big_integer_view &other) const
+{
+    return compare(other) < 0;
+}
+
+/**
+ * @param other the number to compare to
+ * @return true if this >= other
+ */
+bool big_integer_view::operator>=(const big_integer_view &other) const
+{
+    return compare(other) >= 0;
+}
+
+/**
+ * @param other the number to compare to
+ * @return true if this <= other
+ */
+bool big_integer_view::operator<=(const big_integer_view &other) const
+{
+    return compare(other) <= 0;
+}
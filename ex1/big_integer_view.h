@@ -0,0 +1,151 @@
+#ifndef EX1_BIG_INTEGER_VIEW_H
+#define EX1_BIG_INTEGER_VIEW_H
+
+#include <cstddef>
+#include "big_integer.h"
+
+/**
+ * a read only number that stays in the bytes of its binary encoding (big_integer::serialize).
+ * opening a view only checks the header, the limbs are read from the buffer when they are
+ * used, so a large value in a memory mapped file is available without parsing or copying it.
+ * the buffer must outlive the view and must not change while the view is used. converting a
+ * view to big_integer copies its limbs once.
+ * @author Idan Yamin
+ * @class big_integer_view
+ */
+class big_integer_view
+{
+public:
+    /* a single digit of the magnitude in base 2^64 */
+    typedef big_integer::limb_t limb_t;
+
+    /**
+     * default constructor, a view of 0
+     */
+    big_integer_view() : _limbs(nullptr), _size(0), _isNegative(false)
+    {};
+
+    /**
+     * open a view over an encoding written by big_integer::serialize
+     * @param buffer the encoding, at any alignment
+     * @param size number of bytes available in buffer, it may hold more after the encoding
+     * @param view output, a view of 0 if the encoding is invalid
+     * @return the number of bytes of the encoding, where the next one may start. 0 if the
+     * encoding is truncated, has an unknown version or is not normalized
+     */
+    static size_t open(const unsigned char *buffer, size_t size, big_integer_view &view);
+
+    /**
+     * @return the number of limbs of the magnitude, 0 for 0
+     */
+    size_t size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @return true if the number is negative
+     */
+    bool is_negative() const
+    {
+        return _isNegative;
+    }
+
+    /**
+     * @param index a limb index below size()
+     * @return the limb, the least significant is 0
+     */
+    limb_t limb(size_t index) const
+    {
+        limb_t value;
+        big_integer::_readLimbs(&value, _limbs + index * sizeof(limb_t), 1);
+        return value;
+    }
+
+    /**
+     * @return the stored limbs, 8 little endian bytes each, in the buffer of the view
+     */
+    const unsigned char *limb_bytes() const
+    {
+        return _limbs;
+    }
+
+    /**
+     * copy the number out of the buffer
+     * @return the value as a big_integer
+     */
+    explicit operator big_integer() const;
+
+    /**
+     * three way comparison, scans the limbs from the most significant end
+     * @param other the number to compare to
+     * @return -1 if this < other, 0 if they are equal, 1 if this > other
+     */
+    int compare(const big_integer_view &other) const;
+
+    /**
+     * three way comparison without copying the view
+     * @param num the number to compare to
+     * @return -1 if this < num, 0 if they are equal, 1 if this > num
+     */
+    int compare(const big_integer &num) const;
+
+    /**
+     * @param other the number to compare to
+     * @return true if this == other
+     */
+    bool operator==(const big_integer_view &other) const;
+
+    /**
+     * @param other the number to compare to
+     * @return true if this != other
+     */
+    bool operator!=(const big_integer_view &other) const;
+
+    /**
+     * @param other the number to compare to
+     * @return true if this > other
+     */
+    bool operator>(const big_integer_view &other) const;
+
+    /**
+     * @param other the number to compare to
+     * @return true if this < other
+     */
+    bool operator<(const big_integer_view &other) const;
+
+    /**
+     * @param other the number to compare to
+     * @return true if this >= other
+     */
+    bool operator>=(const big_integer_view &other) const;
+
+    /**
+     * @param other the number to compare to
+     * @return true if this <= other
+     */
+    bool operator<=(const big_integer_view &other) const;
+
+private:
+    /* the stored limbs in the buffer, least significant first */
+    const unsigned char *_limbs;
+
+    /* number of limbs, normalized like big_integer: the top limb is not 0 */
+    size_t _size;
+
+    /* the sign, false for 0 */
+    bool _isNegative;
+
+    /**
+    * compare to a number given by its sign and limbs
+    * @param negative the sign of the other number
+    * @param size number of limbs of the other number
+    * @param limbOf the limb of the other number at an index
+    * @return -1 if this is smaller, 0 if they are equal, 1 if this is larger
+    */
+    template<class LimbOf>
+    int _compare(bool negative, size_t size, const LimbOf &limbOf) const;
+};
+
+
+#endif //EX1_BIG_INTEGER_VIEW_H
@@ -0,0 +1,196 @@
+#ifndef EX1_LIMB_ALLOCATOR_H
+#define EX1_LIMB_ALLOCATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+/**
+ * a source of heap buffers for limb_vector, in the spirit of std::pmr::memory_resource.
+ * a vector takes the allocator that is current on its thread when it is constructed and
+ * gives every buffer back to that same allocator. the current allocator is changed by
+ * limb_allocator_scope, nullptr stands for the global heap (new[] and delete[]).
+ * @author Idan Yamin
+ * @class limb_allocator
+ */
+class limb_allocator
+{
+public:
+    /* the element type */
+    typedef std::uint64_t value_type;
+
+    /**
+     * destructor
+     */
+    virtual ~limb_allocator() = default;
+
+    /**
+     * @param count number of limbs, not 0
+     * @return a buffer of count limbs
+     */
+    virtual value_type *allocate(size_t count) = 0;
+
+    /**
+     * give back a buffer of allocate
+     * @param data the buffer
+     * @param count number of limbs it was allocated with
+     */
+    virtual void deallocate(value_type *data, size_t count) = 0;
+
+    /**
+     * @return the allocator that limb vectors constructed now on this thread use,
+     * nullptr for the global heap
+     */
+    static limb_allocator *current()
+    {
+        return _current();
+    }
+
+private:
+    friend class limb_allocator_scope;
+
+    /**
+    * @return the current allocator of this thread, a constant initialized thread local
+    */
+    static limb_allocator *&_current()
+    {
+        static thread_local limb_allocator *current = nullptr;
+        return current;
+    }
+};
+
+/**
+ * makes an allocator the current one of this thread for the lifetime of the scope object,
+ * the previous one is current again when it dies. scopes nest like the blocks holding them.
+ * @class limb_allocator_scope
+ */
+class limb_allocator_scope
+{
+public:
+    /**
+     * constructor
+     * @param allocator the allocator to use, nullptr for the global heap
+     */
+    explicit limb_allocator_scope(limb_allocator *allocator) : _previous(limb_allocator::_current())
+    {
+        limb_allocator::_current() = allocator;
+    }
+
+    /**
+     * destructor, restores the previous allocator
+     */
+    ~limb_allocator_scope()
+    {
+        limb_allocator::_current() = _previous;
+    }
+
+    limb_allocator_scope(const limb_allocator_scope &) = delete;
+
+    limb_allocator_scope &operator=(const limb_allocator_scope &) = delete;
+
+private:
+    /* the allocator that was current before this scope */
+    limb_allocator *_previous;
+};
+
+/**
+ * a monotonic arena: limbs are carved out of large blocks with a pointer bump, giving a
+ * buffer back is free (the most recent one is reused right away) and all the blocks are
+ * released at once when the arena dies.
+ * the arena is the current allocator of its thread for its whole lifetime, so declaring one
+ * around a computation moves every limb vector built inside it off the global heap.
+ * numbers built inside must not outlive the arena. to keep a result, move or copy it into a
+ * number constructed before the arena: a vector keeps its own allocator on assignment.
+ * @class limb_arena
+ */
+class limb_arena : public limb_allocator
+{
+public:
+    /* limbs in the first block (64 KiB), later blocks double */
+    static const size_t DEFAULT_BLOCK_LIMBS = 8192;
+
+    /**
+     * constructor, makes the arena the current allocator of this thread
+     * @param blockLimbs number of limbs in the first block
+     */
+    explicit limb_arena(size_t blockLimbs = DEFAULT_BLOCK_LIMBS)
+            : _blocks(nullptr), _next(nullptr), _end(nullptr),
+              _blockLimbs(std::max(blockLimbs, size_t(1))), _scope(this)
+    {};
+
+    /**
+     * destructor, restores the previous allocator and frees every block
+     */
+    ~limb_arena() override
+    {
+        while (_blocks != nullptr)
+        {
+            value_type *previous = reinterpret_cast<value_type *>(_blocks[0]);
+            delete[] _blocks;
+            _blocks = previous;
+        }
+    }
+
+    limb_arena(const limb_arena &) = delete;
+
+    limb_arena &operator=(const limb_arena &) = delete;
+
+    /**
+     * @param count number of limbs, not 0
+     * @return a buffer of count limbs
+     */
+    value_type *allocate(size_t count) override
+    {
+        if (size_t(_end - _next) < count)
+        {
+            _newBlock(count);
+        }
+        value_type *data = _next;
+        _next += count;
+        return data;
+    }
+
+    /**
+     * give back a buffer, only the most recent one is reused before the arena dies
+     * @param data the buffer
+     * @param count number of limbs it was allocated with
+     */
+    void deallocate(value_type *data, size_t count) override
+    {
+        if (data + count == _next)
+        {
+            _next = data;
+        }
+    }
+
+private:
+    /* the newest block, its first limb links to the previous block */
+    value_type *_blocks;
+
+    /* the free part of the newest block */
+    value_type *_next, *_end;
+
+    /* number of limbs in the next block */
+    size_t _blockLimbs;
+
+    /* keeps this arena current while it lives, constructed last and destroyed first */
+    limb_allocator_scope _scope;
+
+    /**
+    * start a new block with room for at least count limbs
+    * @param count the minimal room
+    */
+    void _newBlock(size_t count)
+    {
+        size_t limbs = std::max(count, _blockLimbs);
+        value_type *block = new value_type[limbs + 1];
+        block[0] = reinterpret_cast<std::uintptr_t>(_blocks);
+        _blocks = block;
+        _next = block + 1;
+        _end = _next + limbs;
+        _blockLimbs *= 2;
+    }
+};
+
+
+#endif //EX1_LIMB_ALLOCATOR_H
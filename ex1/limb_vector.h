@@ -0,0 +1,423 @@
+#ifndef EX1_LIMB_VECTOR_H
+#define EX1_LIMB_VECTOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "limb_allocator.h"
+
+/**
+ * a growable array of 64 bit limbs that keeps up to INLINE_CAPACITY limbs inside the
+ * object itself, so word sized integers never touch the heap. longer contents spill
+ * to a heap buffer that grows geometrically and is kept until the vector dies.
+ * heap buffers come from the limb_allocator that was current when the vector was
+ * constructed (see limb_allocator.h), the allocator stays with the vector for its life.
+ * the subset of the std::vector interface used by big_integer is provided.
+ * @author Idan Yamin
+ * @class limb_vector
+ */
+class limb_vector
+{
+public:
+    /* the element type */
+    typedef std::uint64_t value_type;
+
+    /* iterators are plain pointers */
+    typedef value_type *iterator;
+    typedef const value_type *const_iterator;
+
+    /* number of limbs stored without a heap allocation (128 bits) */
+    static const size_t INLINE_CAPACITY = 2;
+
+    /**
+     * default constructor, an empty vector
+     */
+    limb_vector() : limb_vector(limb_allocator::current())
+    {};
+
+    /**
+     * construct an empty vector that takes its buffers from allocator
+     * @param allocator the allocator, nullptr for the global heap
+     */
+    explicit limb_vector(limb_allocator *allocator) : _data(_inline), _size(0),
+                                                      _capacity(INLINE_CAPACITY),
+                                                      _allocator(allocator)
+    {};
+
+    /**
+     * construct a vector of count zero limbs
+     * @param count number of limbs
+     */
+    explicit limb_vector(size_t count) : limb_vector()
+    {
+        resize(count);
+    }
+
+    /**
+     * copy constructor
+     * @param other the vector to copy
+     */
+    limb_vector(const limb_vector &other) : limb_vector()
+    {
+        assign(other.begin(), other.end());
+    }
+
+    /**
+     * move constructor, steals the heap buffer of other together with its allocator
+     * @param other the vector to move from
+     */
+    limb_vector(limb_vector &&other) noexcept : limb_vector(other._allocator)
+    {
+        _steal(other);
+    }
+
+    /**
+     * destructor
+     */
+    ~limb_vector()
+    {
+        _release();
+    }
+
+    /**
+     * copy other into this, reusing this buffer when it is large enough
+     * @param other the vector to copy
+     * @return this vector
+     */
+    limb_vector &operator=(const limb_vector &other)
+    {
+        if (this != &other)
+        {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    /**
+     * move other into this, other is left empty. a heap buffer of another allocator is
+     * copied rather than stolen, so this keeps its own allocator.
+     * @param other the vector to move from
+     * @return this vector
+     */
+    limb_vector &operator=(limb_vector &&other) noexcept
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+        if (other._data == other._inline || other._allocator == _allocator)
+        {
+            _release();
+            _steal(other);
+        }
+        else
+        {
+            assign(other.begin(), other.end());
+            other.clear();
+        }
+        return *this;
+    }
+
+    /**
+     * @return pointer to the first limb
+     */
+    value_type *data()
+    {
+        return _data;
+    }
+
+    /**
+     * @return pointer to the first limb
+     */
+    const value_type *data() const
+    {
+        return _data;
+    }
+
+    /**
+     * @return number of limbs
+     */
+    size_t size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @return number of limbs that fit without reallocating
+     */
+    size_t capacity() const
+    {
+        return _capacity;
+    }
+
+    /**
+     * @return true if there are no limbs
+     */
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @return the allocator of the heap buffers, nullptr for the global heap
+     */
+    limb_allocator *get_allocator() const
+    {
+        return _allocator;
+    }
+
+    /**
+     * @return true if the limbs are stored inside the object
+     */
+    bool is_inline() const
+    {
+        return _data == _inline;
+    }
+
+    /**
+     * @param index index of a limb
+     * @return the limb at index
+     */
+    value_type &operator[](size_t index)
+    {
+        return _data[index];
+    }
+
+    /**
+     * @param index index of a limb
+     * @return the limb at index
+     */
+    const value_type &operator[](size_t index) const
+    {
+        return _data[index];
+    }
+
+    /**
+     * @return the most significant limb
+     */
+    value_type &back()
+    {
+        return _data[_size - 1];
+    }
+
+    /**
+     * @return the most significant limb
+     */
+    const value_type &back() const
+    {
+        return _data[_size - 1];
+    }
+
+    /**
+     * @return iterator to the first limb
+     */
+    iterator begin()
+    {
+        return _data;
+    }
+
+    /**
+     * @return iterator past the last limb
+     */
+    iterator end()
+    {
+        return _data + _size;
+    }
+
+    /**
+     * @return iterator to the first limb
+     */
+    const_iterator begin() const
+    {
+        return _data;
+    }
+
+    /**
+     * @return iterator past the last limb
+     */
+    const_iterator end() const
+    {
+        return _data + _size;
+    }
+
+    /**
+     * remove all limbs, the buffer is kept
+     */
+    void clear()
+    {
+        _size = 0;
+    }
+
+    /**
+     * make sure count limbs fit without reallocating
+     * @param count number of limbs
+     */
+    void reserve(size_t count)
+    {
+        if (count > _capacity)
+        {
+            _grow(count);
+        }
+    }
+
+    /**
+     * change the number of limbs, new limbs are zero
+     * @param count the new number of limbs
+     */
+    void resize(size_t count)
+    {
+        reserve(count);
+        if (count > _size)
+        {
+            std::fill(_data + _size, _data + count, value_type(0));
+        }
+        _size = count;
+    }
+
+    /**
+     * replace the contents with count copies of value
+     * @param count number of limbs
+     * @param value the value of every limb
+     */
+    void assign(size_t count, value_type value)
+    {
+        _size = 0;
+        reserve(count);
+        std::fill(_data, _data + count, value);
+        _size = count;
+    }
+
+    /**
+     * replace the contents with the limbs in [first, last), which must not point into this
+     * @param first pointer to the first limb
+     * @param last pointer past the last limb
+     */
+    void assign(const value_type *first, const value_type *last)
+    {
+        size_t count = size_t(last - first);
+        _size = 0;
+        reserve(count);
+        std::copy(first, last, _data);
+        _size = count;
+    }
+
+    /**
+     * append a limb
+     * @param value the limb
+     */
+    void push_back(value_type value)
+    {
+        if (_size == _capacity)
+        {
+            _grow(_capacity * 2);
+        }
+        _data[_size++] = value;
+    }
+
+    /**
+     * remove the most significant limb
+     */
+    void pop_back()
+    {
+        _size--;
+    }
+
+    /**
+     * compare the limbs of two vectors
+     * @param other the other vector
+     * @return true if both hold the same limbs
+     */
+    bool operator==(const limb_vector &other) const
+    {
+        return _size == other._size && std::equal(begin(), end(), other.begin());
+    }
+
+    /**
+     * compare the limbs of two vectors
+     * @param other the other vector
+     * @return true if the vectors hold different limbs
+     */
+    bool operator!=(const limb_vector &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    /* the limbs, points either to _inline or to a heap buffer */
+    value_type *_data;
+
+    /* number of limbs in use */
+    size_t _size;
+
+    /* number of limbs _data can hold */
+    size_t _capacity;
+
+    /* where the heap buffers come from, nullptr for the global heap */
+    limb_allocator *_allocator;
+
+    /* storage for short vectors */
+    value_type _inline[INLINE_CAPACITY];
+
+    /**
+     * move the limbs to a heap buffer of at least count limbs
+     * @param count the minimal capacity
+     */
+    void _grow(size_t count)
+    {
+        size_t newCapacity = std::max(count, _capacity * 2);
+        value_type *newData = _allocator != nullptr ? _allocator->allocate(newCapacity)
+                                                    : new value_type[newCapacity];
+        if (_size != 0)
+        {
+            std::copy(_data, _data + _size, newData);
+        }
+        _release();
+        _data = newData;
+        _capacity = newCapacity;
+    }
+
+    /**
+     * free the heap buffer (if any) and go back to the inline storage
+     */
+    void _release()
+    {
+        if (_data != _inline)
+        {
+            if (_allocator != nullptr)
+            {
+                _allocator->deallocate(_data, _capacity);
+            }
+            else
+            {
+                delete[] _data;
+            }
+        }
+        _data = _inline;
+        _capacity = INLINE_CAPACITY;
+    }
+
+    /**
+     * take the contents of other, which is left empty, this must be released. a heap buffer
+     * must come from the allocator of this.
+     * @param other the vector to take from
+     */
+    void _steal(limb_vector &other)
+    {
+        if (other._data == other._inline)
+        {
+            std::copy(other._inline, other._inline + other._size, _inline);
+        }
+        else
+        {
+            _data = other._data;
+            _capacity = other._capacity;
+            other._data = other._inline;
+            other._capacity = INLINE_CAPACITY;
+        }
+        _size = other._size;
+        other._size = 0;
+    }
+};
+
+
+#endif //EX1_LIMB_VECTOR_H
@@ -0,0 +1,321 @@
+#include <algorithm>
+#include "modulus_context.h"
+
+/**
+ * constructor
+ * @param modulus the modulus
+ */
+modulus_context::modulus_context(const big_integer &modulus) : _modulus(modulus),
+                                                                _len(modulus._limbs.size()),
+                                                                _inverse(0)
+{
+    _modulus._isPositive = true;
+    _modulus._resetHash();
+    if (_len == 0)
+    {
+        return;
+    }
+    const limb_vector &mod = _modulus._limbs;
+
+    // dividing 2^(2 * 64 * _len) - 1 keeps the reciprocal below 2^(64 * (_len + 1)) even for
+    // a modulus that is a power of 2^64, and costs barrett at most one more correction
+    limb_vector power, remainder;
+    power.assign(2 * _len, ~limb_t(0));
+    big_integer::_divideMagnitude(power, mod, _reciprocal, remainder);
+    _reciprocal.resize(_len + 1);
+    if ((mod[0] & 1) != 0)
+    {
+        _inverse = big_integer::_montgomeryConstants(mod, _rSquared);
+    }
+
+    // two residues, a 2 * _len product, the barrett products q * reciprocal and q * modulus,
+    // the _len + 1 limb barrett remainder and the temporaries of the product
+    _scratch.resize(9 * _len + 4 + big_integer::_multiplyScratchSize(_len));
+}
+
+/**
+ * reduce a number of any length and sign
+ * @param num the number
+ * @param result output, num mod modulus, may be num itself
+ */
+void modulus_context::reduce(const big_integer &num, big_integer &result) const
+{
+    if (_len == 0)
+    {
+        result._initDataMembers();
+        return;
+    }
+    limb_t *residue = _scratch.data();
+    _residue(num, residue);
+    _store(residue, result);
+}
+
+/**
+ * @param num the number
+ * @return num mod modulus
+ */
+big_integer modulus_context::reduce(const big_integer &num) const
+{
+    big_integer res;
+    reduce(num, res);
+    return res;
+}
+
+/**
+ * modular multiplication, operands outside [0, modulus) are reduced first
+ * @param num1 a number
+ * @param num2 a number
+ * @param result output, num1 * num2 mod modulus, may be an operand
+ */
+void modulus_context::mulmod(const big_integer &num1, const big_integer &num2,
+                             big_integer &result) const
+{
+    if (_len == 0)
+    {
+        result._initDataMembers();
+        return;
+    }
+    limb_t *residue1 = _scratch.data(), *residue2 = residue1 + _len;
+    limb_t *product = residue2 + _len;
+    _residue(num1, residue1);
+    _residue(num2, residue2);
+    big_integer::_multiplyInScratch(product, residue1, residue2, _len,
+                                    _scratch.data() + 9 * _len + 4);
+    _barrett(residue1, product);
+    _store(residue1, result);
+}
+
+/**
+ * @param num1 a number
+ * @param num2 a number
+ * @return num1 * num2 mod modulus
+ */
+big_integer modulus_context::mulmod(const big_integer &num1, const big_integer &num2) const
+{
+    big_integer res;
+    mulmod(num1, num2, res);
+    return res;
+}
+
+/**
+ * modular addition, operands outside [0, modulus) are reduced first
+ * @param num1 a number
+ * @param num2 a number
+ * @param result output, num1 + num2 mod modulus, may be an operand
+ */
+void modulus_context::addmod(const big_integer &num1, const big_integer &num2,
+                             big_integer &result) const
+{
+    if (_len == 0)
+    {
+        result._initDataMembers();
+        return;
+    }
+    limb_t *residue1 = _scratch.data(), *residue2 = residue1 + _len;
+    const limb_t *mod = _modulus._limbs.data();
+    _residue(num1, residue1);
+    _residue(num2, residue2);
+    // the sum is below 2 * modulus, one substraction brings it back
+    limb_t carry = big_integer::_add(residue1, residue1, _len, residue2, _len);
+    if (carry != 0 || big_integer::_compareMagnitude(residue1, _len, mod, _len) >= 0)
+    {
+        big_integer::_substract(residue1, residue1, _len, mod, _len);
+    }
+    _store(residue1, result);
+}
+
+/**
+ * @param num1 a number
+ * @param num2 a number
+ * @return num1 + num2 mod modulus
+ */
+big_integer modulus_context::addmod(const big_integer &num1, const big_integer &num2) const
+{
+    big_integer res;
+    addmod(num1, num2, res);
+    return res;
+}
+
+/**
+ * modular substraction, operands outside [0, modulus) are reduced first
+ * @param num1 a number
+ * @param num2 a number
+ * @param result output, num1 - num2 mod modulus, may be an operand
+ */
+void modulus_context::submod(const big_integer &num1, const big_integer &num2,
+                             big_integer &result) const
+{
+    if (_len == 0)
+    {
+        result._initDataMembers();
+        return;
+    }
+    limb_t *residue1 = _scratch.data(), *residue2 = residue1 + _len;
+    _residue(num1, residue1);
+    _residue(num2, residue2);
+    // a negative difference wraps around, adding modulus wraps it back
+    if (big_integer::_substract(residue1, residue1, _len, residue2, _len) != 0)
+    {
+        big_integer::_add(residue1, residue1, _len, _modulus._limbs.data(), _len);
+    }
+    _store(residue1, result);
+}
+
+/**
+ * @param num1 a number
+ * @param num2 a number
+ * @return num1 - num2 mod modulus
+ */
+big_integer modulus_context::submod(const big_integer &num1, const big_integer &num2) const
+{
+    big_integer res;
+    submod(num1, num2, res);
+    return res;
+}
+
+/**
+ * big_integer::powmod on the precomputed montgomery constants
+ * @param base the base
+ * @param exponent the exponent, must not be negative
+ * @return base^exponent mod modulus, 0 for a negative exponent
+ */
+big_integer modulus_context::powmod(const big_integer &base, const big_integer &exponent) const
+{
+    return _powmod(base, exponent, false);
+}
+
+/**
+ * big_integer::powmod_constant_time on the precomputed montgomery constants
+ * @param base the base
+ * @param exponent the exponent, must not be negative
+ * @return base^exponent mod modulus, 0 for a negative exponent
+ */
+big_integer modulus_context::powmod_constant_time(const big_integer &base,
+                                                  const big_integer &exponent) const
+{
+    return _powmod(base, exponent, true);
+}
+
+/**
+ * barrett reduction, result = num mod modulus
+ * @param result output of _len limbs
+ * @param num 2 * _len limbs
+ */
+void modulus_context::_barrett(limb_t *result, const limb_t *num) const
+{
+    size_t len = _len;
+    const limb_t *mod = _modulus._limbs.data();
+    limb_t *estimate = _scratch.data() + 4 * len;
+    limb_t *multiple = estimate + 2 * len + 2;
+    limb_t *remainder = multiple + 2 * len + 1;
+
+    // q = floor(floor(num / B^(len - 1)) * reciprocal / B^(len + 1)) is at most 3 below the
+    // real quotient even when the product columns below len - 1 are skipped
+    const limb_t *top = num + len - 1, *reciprocal = _reciprocal.data();
+    std::fill(estimate + len - 1, estimate + 2 * len + 2, limb_t(0));
+    for (size_t i = 0; i <= len; i++)
+    {
+        size_t skip = i + 1 < len ? len - 1 - i : 0;
+        estimate[i + len + 1] = big_integer::_addMultiplyRow(estimate + i + skip, reciprocal + skip,
+                                                             len + 1 - skip, top[i]);
+    }
+    const limb_t *quotient = estimate + len + 1;
+
+    // only the low len + 1 limbs of num - q * modulus are needed, the rest cancels
+    std::fill(multiple, multiple + len + 1, limb_t(0));
+    multiple[len] = big_integer::_addMultiplyRow(multiple, mod, len, quotient[0]);
+    for (size_t i = 1; i <= len; i++)
+    {
+        big_integer::_addMultiplyRow(multiple + i, mod, len + 1 - i, quotient[i]);
+    }
+    big_integer::_substract(remainder, num, len + 1, multiple, len + 1);
+    while (remainder[len] != 0 || big_integer::_compareMagnitude(remainder, len, mod, len) >= 0)
+    {
+        limb_t borrow = big_integer::_substract(remainder, remainder, len, mod, len);
+        remainder[len] -= borrow;
+    }
+    std::copy(remainder, remainder + len, result);
+}
+
+/**
+ * write the residue of a number
+ * @param num a number of any length and sign
+ * @param result output of _len limbs
+ */
+void modulus_context::_residue(const big_integer &num, limb_t *result) const
+{
+    size_t len = _len, numLen = num._limbs.size();
+    const limb_t *limbs = num._limbs.data();
+    const limb_t *mod = _modulus._limbs.data();
+    if (numLen < len || (numLen == len && big_integer::_compareMagnitude(limbs, len, mod, len) < 0))
+    {
+        std::copy(limbs, limbs + numLen, result);
+        std::fill(result + numLen, result + len, limb_t(0));
+    }
+    else
+    {
+        // the top chunk (up to 2 * len limbs) is reduced first, the rest is folded len limbs at
+        // a time: residue = (residue * B^len + chunk) mod modulus
+        limb_t *window = _scratch.data() + 2 * len;
+        size_t rest = (numLen - 1) % len + 1;
+        size_t top = numLen >= rest + len ? rest + len : rest;
+        size_t position = numLen - top;
+        std::copy(limbs + position, limbs + numLen, window);
+        std::fill(window + top, window + 2 * len, limb_t(0));
+        _barrett(result, window);
+        while (position > 0)
+        {
+            position -= len;
+            std::copy(limbs + position, limbs + position + len, window);
+            std::copy(result, result + len, window + len);
+            _barrett(result, window);
+        }
+    }
+    // the residue of a negative number is modulus - |num| mod modulus
+    if (!num._isPositive && big_integer::_trimmedLength(result, len) != 0)
+    {
+        big_integer::_substract(result, mod, len, result, len);
+    }
+}
+
+/**
+ * store a residue in a big integer
+ * @param residue _len limbs
+ * @param result output
+ */
+void modulus_context::_store(const limb_t *residue, big_integer &result) const
+{
+    result._limbs.assign(residue, residue + big_integer::_trimmedLength(residue, _len));
+    result._isPositive = true;
+    result._resetHash();
+}
+
+/**
+ * shared body of powmod and powmod_constant_time
+ * @param base the base
+ * @param exponent the exponent
+ * @param constantTime true to hide the bits of the exponent
+ * @return base^exponent mod modulus
+ */
+big_integer modulus_context::_powmod(const big_integer &base, const big_integer &exponent,
+                                     bool constantTime) const
+{
+    big_integer res;
+    const limb_vector &mod = _modulus._limbs;
+    if (big_integer::_powmodTrivial(exponent, mod, res))
+    {
+        return res;
+    }
+    big_integer reduced;
+    reduce(base, reduced);
+    if ((mod[0] & 1) != 0)
+    {
+        big_integer::_powmodMontgomery(res._limbs, reduced._limbs, exponent._limbs, mod, _rSquared,
+                                       _inverse, constantTime);
+    }
+    else
+    {
+        big_integer::_powmodDivision(res._limbs, reduced._limbs, exponent._limbs, mod);
+    }
+    return res;
+}
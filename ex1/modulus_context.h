@@ -0,0 +1,164 @@
+#ifndef EX1_MODULUS_CONTEXT_H
+#define EX1_MODULUS_CONTEXT_H
+
+#include <cstddef>
+#include "big_integer.h"
+
+/**
+ * modular arithmetic against one fixed modulus. the constructor precomputes the barrett
+ * reciprocal (and for an odd modulus the montgomery constants) and sizes a scratch buffer,
+ * so reducing many values costs no division and the output parameter versions allocate
+ * nothing once the result has room for the modulus.
+ * every result is the non negative residue in [0, |modulus|), the sign of the modulus is
+ * ignored and a 0 modulus makes every result 0.
+ * the scratch buffer is shared by all calls, so an object must not be used by several threads
+ * at once, copies are independent.
+ * @author Idan Yamin
+ * @class modulus_context
+ */
+class modulus_context
+{
+public:
+    /**
+     * constructor
+     * @param modulus the modulus
+     */
+    explicit modulus_context(const big_integer &modulus);
+
+    /**
+     * @return the modulus, non negative
+     */
+    const big_integer &modulus() const
+    {
+        return _modulus;
+    }
+
+    /**
+     * reduce a number of any length and sign
+     * @param num the number
+     * @param result output, num mod modulus, may be num itself
+     */
+    void reduce(const big_integer &num, big_integer &result) const;
+
+    /**
+     * @param num the number
+     * @return num mod modulus
+     */
+    big_integer reduce(const big_integer &num) const;
+
+    /**
+     * modular multiplication, operands outside [0, modulus) are reduced first
+     * @param num1 a number
+     * @param num2 a number
+     * @param result output, num1 * num2 mod modulus, may be an operand
+     */
+    void mulmod(const big_integer &num1, const big_integer &num2, big_integer &result) const;
+
+    /**
+     * @param num1 a number
+     * @param num2 a number
+     * @return num1 * num2 mod modulus
+     */
+    big_integer mulmod(const big_integer &num1, const big_integer &num2) const;
+
+    /**
+     * modular addition, operands outside [0, modulus) are reduced first
+     * @param num1 a number
+     * @param num2 a number
+     * @param result output, num1 + num2 mod modulus, may be an operand
+     */
+    void addmod(const big_integer &num1, const big_integer &num2, big_integer &result) const;
+
+    /**
+     * @param num1 a number
+     * @param num2 a number
+     * @return num1 + num2 mod modulus
+     */
+    big_integer addmod(const big_integer &num1, const big_integer &num2) const;
+
+    /**
+     * modular substraction, operands outside [0, modulus) are reduced first
+     * @param num1 a number
+     * @param num2 a number
+     * @param result output, num1 - num2 mod modulus, may be an operand
+     */
+    void submod(const big_integer &num1, const big_integer &num2, big_integer &result) const;
+
+    /**
+     * @param num1 a number
+     * @param num2 a number
+     * @return num1 - num2 mod modulus
+     */
+    big_integer submod(const big_integer &num1, const big_integer &num2) const;
+
+    /**
+     * big_integer::powmod on the precomputed montgomery constants
+     * @param base the base
+     * @param exponent the exponent, must not be negative
+     * @return base^exponent mod modulus, 0 for a negative exponent
+     */
+    big_integer powmod(const big_integer &base, const big_integer &exponent) const;
+
+    /**
+     * big_integer::powmod_constant_time on the precomputed montgomery constants
+     * @param base the base
+     * @param exponent the exponent, must not be negative
+     * @return base^exponent mod modulus, 0 for a negative exponent
+     */
+    big_integer powmod_constant_time(const big_integer &base, const big_integer &exponent) const;
+
+private:
+    typedef big_integer::limb_t limb_t;
+
+    /* the magnitude of the modulus */
+    big_integer _modulus;
+
+    /* number of limbs of the modulus */
+    size_t _len;
+
+    /* floor((2^(2 * 64 * _len) - 1) / modulus), _len + 1 limbs */
+    limb_vector _reciprocal;
+
+    /* 2^(2 * 64 * _len) mod modulus, only for an odd modulus */
+    limb_vector _rSquared;
+
+    /* -modulus^-1 mod 2^64, only for an odd modulus */
+    limb_t _inverse;
+
+    /* room for two residues, a product, its karatsuba temporaries and the barrett quotients */
+    mutable limb_vector _scratch;
+
+    /**
+    * barrett reduction, result = num mod modulus
+    * @param result output of _len limbs
+    * @param num 2 * _len limbs
+    */
+    void _barrett(limb_t *result, const limb_t *num) const;
+
+    /**
+    * write the residue of a number
+    * @param num a number of any length and sign
+    * @param result output of _len limbs
+    */
+    void _residue(const big_integer &num, limb_t *result) const;
+
+    /**
+    * store a residue in a big integer
+    * @param residue _len limbs
+    * @param result output
+    */
+    void _store(const limb_t *residue, big_integer &result) const;
+
+    /**
+    * shared body of powmod and powmod_constant_time
+    * @param base the base
+    * @param exponent the exponent
+    * @param constantTime true to hide the bits of the exponent
+    * @return base^exponent mod modulus
+    */
+    big_integer _powmod(const big_integer &base, const big_integer &exponent,
+                        bool constantTime) const;
+};
+
+
+#endif //EX1_MODULUS_CONTEXT_H
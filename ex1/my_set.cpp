@@ -240,14 +240,15 @@ my_set my_set::operator-(const my_set &other) const
     my_set newSet = my_set();
     while (curThis != nullptr && curOther != nullptr)
     {
+        int cmp = curThis->_data.compare(curOther->_data);
         // in this case curThis doesn't in other
-        if (curThis->_data < curOther->_data)
+        if (cmp < 0)
         {
             newSet.add(curThis->_data);
             curThis = curThis->_next;
         }
             // the value on other is in this.
-        else if (curThis->_data == curOther->_data)
+        else if (cmp == 0)
         {
             curOther = curOther->_next;
             curThis = curThis->_next;
@@ -290,13 +291,14 @@ my_set my_set::operator|(const my_set &other) const
     Node *curOther = other._head;
     while (curOther != nullptr && curThis != nullptr)
     {
+        int cmp = curThis->_data.compare(curOther->_data);
         // in this case other is not this
-        if (curThis->_data > curOther->_data)
+        if (cmp > 0)
         {
             unionSet.add(curOther->_data);
             curOther = curOther->_next;
         }
-        else if (curThis->_data == curOther->_data)
+        else if (cmp == 0)
         {
             curThis = curThis->_next;
             curOther = curOther->_next;
@@ -321,13 +323,14 @@ my_set my_set::operator&(const my_set &other) const
     my_set newSet = my_set();
     while (curThis != nullptr && curOther != nullptr)
     {
+        int cmp = curThis->_data.compare(curOther->_data);
         // in this case curThis doesn't in other
-        if (curThis->_data < curOther->_data)
+        if (cmp < 0)
         {
             curThis = curThis->_next;
         }
             // the value on other is in this.
-        else if (curThis->_data == curOther->_data)
+        else if (cmp == 0)
         {
             newSet.add(curThis->_data);
             curOther = curOther->_next;